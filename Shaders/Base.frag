@@ -21,7 +21,12 @@ uniform float uTextureFactor;
 
 // Tex coord input from vertex shader
 in vec2 fragTexCoord;
-uniform float fade;         // 0 = fully visible, 1 = fully black
+// Per-frame constants, uploaded once per frame by the renderer
+layout (std140) uniform FrameData
+{
+	mat4 uOrthoProj;
+	float fade;         // 0 = fully visible, 1 = fully black
+};
 
 void main()
 {
@@ -16,7 +16,12 @@ layout (location = 0) in vec2 inPosition;
 layout(location = 1) in vec2 inTexCoord;
 
 uniform mat4 uWorldTransform;
-uniform mat4 uOrthoProj;
+// Per-frame constants, uploaded once per frame by the renderer
+layout (std140) uniform FrameData
+{
+	mat4 uOrthoProj;
+	float fade;         // 0 = fully visible, 1 = fully black
+};
 uniform vec3 uColor;
 uniform vec2 uCameraPos;
 
@@ -0,0 +1,31 @@
+// Request GLSL 3.3
+#version 330
+
+// This corresponds to the output color to the color buffer
+out vec4 outColor;
+
+// This is used for the texture sampling
+uniform sampler2D uTexture;
+
+// Per-vertex inputs from the vertex shader
+in vec2 fragTexCoord;
+in vec3 fragColor;
+in float fragTextureFactor;
+
+// Per-frame constants, uploaded once per frame by the renderer
+layout (std140) uniform FrameData
+{
+	mat4 uOrthoProj;
+	float fade;         // 0 = fully visible, 1 = fully black
+};
+
+void main()
+{
+    vec4 texColor = texture(uTexture, fragTexCoord);
+
+    // Same blending as Base.frag, but with per-vertex color/factor
+    vec4 baseColor = mix(vec4(fragColor, 1.0), texColor, fragTextureFactor);
+
+    // Apply fade: mix between baseColor and black
+    outColor = mix(baseColor, vec4(0.0, 0.0, 0.0, 1.0), fade);
+}
@@ -0,0 +1,28 @@
+// Request GLSL 3.3
+#version 330
+
+// Batched sprite vertices arrive already transformed to view space
+layout (location = 0) in vec2 inPosition;
+layout (location = 1) in vec2 inTexCoord;
+layout (location = 2) in vec3 inColor;
+layout (location = 3) in float inTextureFactor;
+
+// Per-frame constants, uploaded once per frame by the renderer
+layout (std140) uniform FrameData
+{
+	mat4 uOrthoProj;
+	float fade;         // 0 = fully visible, 1 = fully black
+};
+
+out vec2 fragTexCoord;
+out vec3 fragColor;
+out float fragTextureFactor;
+
+void main()
+{
+	gl_Position = uOrthoProj * vec4(inPosition, 0.0, 1.0);
+
+	fragTexCoord = inTexCoord;
+	fragColor = inColor;
+	fragTextureFactor = inTextureFactor;
+}
@@ -11,11 +11,17 @@
     #include "../Components/Component.h"
     #include <algorithm>
     #include "../Components/Physics/AABBColliderComponent.h"
+    #include "../Utils/Profiler.h"
+    #include "../Utils/ObjectManager.h"
+    #include "../Utils/Log.h"
+    #include "../Utils/SceneArena.h"
 
 
     Actor::Actor(Game* game, const std::string& uniqueName)
             : mState(ActorState::Active)
             , mPosition(Vector2::Zero)
+            , mPrevPosition(Vector2::Zero)
+            , mHasPrevPosition(false)
             , mScale(Vector2(1.0f, 1.0f))
             , mRotation(0.0f)
             , mGame(game)
@@ -28,11 +34,24 @@
     {
         mGame->RemoveActor(this);
 
-        for(auto component : mComponents)
+        // Components unregister themselves, so delete from a copy
+        std::vector<Component*> components;
+        components.swap(mComponents);
+        for(auto component : components)
         {
             delete component;
         }
-        mComponents.clear();
+        mComponentTable.clear();
+    }
+
+    void* Actor::operator new(size_t size)
+    {
+        return SceneArena::Get().Allocate(size);
+    }
+
+    void Actor::operator delete(void* p, size_t size)
+    {
+        SceneArena::Get().Free(p);
     }
 
     void Actor::Update(float deltaTime)
@@ -41,11 +60,12 @@
         {
             for (auto comp : mComponents)
             {
-                if (comp->IsEnabled()) {
+                if (comp->UpdatesWithOwner() && comp->IsEnabled()) {
                     comp->Update(deltaTime);
                 }
             }
 
+            PROFILE_SCOPE("Actor::OnUpdate");
             OnUpdate(deltaTime);
         }
     }
@@ -97,22 +117,102 @@
         });
     }
 
+    void Actor::RemoveComponent(Component* c)
+    {
+        auto iter = std::find(mComponents.begin(), mComponents.end(), c);
+        if (iter != mComponents.end())
+        {
+            mComponents.erase(iter);
+        }
+
+        for (auto& entry : mComponentTable)
+        {
+            if (entry == c)
+            {
+                entry = nullptr;
+            }
+        }
+    }
+
+    void Actor::SetPosition(const Vector2& pos)
+    {
+        mPosition = pos;
+
+        for (auto collider : mColliders)
+        {
+            mGame->UpdateCollider(collider);
+        }
+    }
+
+    Vector2 Actor::GetRenderPosition() const
+    {
+        // Actors spawned since the last tick have nothing to interpolate from
+        if (!mHasPrevPosition)
+        {
+            return mPosition;
+        }
+
+        return Vector2::Lerp(mPrevPosition, mPosition, mGame->GetRenderAlpha());
+    }
+
+    void Actor::AddCollider(AABBColliderComponent* collider)
+    {
+        mColliders.emplace_back(collider);
+    }
+
+    void Actor::RemoveCollider(AABBColliderComponent* collider)
+    {
+        auto iter = std::find(mColliders.begin(), mColliders.end(), collider);
+        if (iter != mColliders.end())
+        {
+            mColliders.erase(iter);
+        }
+    }
+
+    void Actor::SetManageable(const bool manageable)
+    {
+        if (manageable == mIsManageable)
+            return;
+
+        mIsManageable = manageable;
+
+        if (ObjectManager* objects = mGame->GetObjectManager())
+        {
+            if (manageable)
+                objects->OnActorAdded(this);
+            else
+                objects->OnActorRemoved(this);
+        }
+    }
+
+    void Actor::SetActorName(const std::string& name)
+    {
+        // The terminal's index is keyed by name, so re-file the actor under the new one
+        ObjectManager* objects = mIsManageable ? mGame->GetObjectManager() : nullptr;
+        if (objects)
+            objects->OnActorRemoved(this);
+
+        mActorName = name;
+
+        if (objects)
+            objects->OnActorAdded(this);
+    }
+
     void Actor::SetScale(const Vector2& scale)
     {
         mScale = scale;
 
         // Repassa a escala para todos os AABBColliderComponents
-        for (Component* comp : mComponents)
+        for (AABBColliderComponent* collider : mColliders)
         {
-            auto collider = dynamic_cast<AABBColliderComponent*>(comp);
-            if (collider && (mScale.x > 1.0f || mScale.y > 1.0f))
+            if (mScale.x > 1.0f || mScale.y > 1.0f)
 
             {
                 // Novo tamanho = tamanho original * escala
-                SDL_Log("scale: %f", scale.x);
+                LOG_DEBUG(Gameplay, "scale: %f", scale.x);
                 int newW = static_cast<int>(collider->mOrigWidth * scale.x);
                 int newH = static_cast<int>(collider->mOrigHeight * scale.y);
-                SDL_Log("Collider before: %d x %d", collider->mWidth, collider->mHeight);
+                LOG_DEBUG(Gameplay, "Collider before: %d x %d", collider->mWidth, collider->mHeight);
 
                 // Quanto o tamanho aumentou
                 float deltaW = newW - collider->mOrigWidth;
@@ -124,7 +224,7 @@
 
                 collider->Resize(newW, newH, newOffset);
 
-                SDL_Log("Collider after: %d x %d", collider->mWidth, collider->mHeight);
+                LOG_DEBUG(Gameplay, "Collider after: %d x %d", collider->mWidth, collider->mHeight);
 
             }
         }
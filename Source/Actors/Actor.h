@@ -10,6 +10,8 @@
 #include <vector>
 #include <SDL_stdinc.h>
 
+#include "ActorHandle.h"
+#include "../Components/ComponentType.h"
 #include "../Math.h"
 #include "../Renderer/Renderer.h"
 
@@ -26,6 +28,10 @@ public:
     Actor(class Game* game, const std::string& uniqueName);
     virtual ~Actor();
 
+    // Instances are allocated from the SceneArena and reclaimed with the scene
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size);
+
     // Update function called from Game (not overridable)
     void Update(float deltaTime);
     // ProcessInput function called from Game (not overridable)
@@ -33,7 +39,12 @@ public:
 
     // Position getter/setter
     const Vector2& GetPosition() const { return mPosition; }
-    void SetPosition(const Vector2& pos) { mPosition = pos; }
+    void SetPosition(const Vector2& pos);
+
+    // Position interpolated between the last two ticks (use for drawing only)
+    Vector2 GetRenderPosition() const;
+    // Stores the current transform as the start of the next tick's interpolation
+    void SnapshotTransform() { mPrevPosition = mPosition; mHasPrevPosition = true; }
 
     // Scale getter/setter
     const Vector2& GetScale() const { return mScale; }
@@ -50,23 +61,44 @@ public:
     // Game getter
     class Game* GetGame() { return mGame; }
 
+    // True while spawned mid-update and not yet in Game's actor list
+    bool IsPendingActor() const { return mIsPendingActor; }
+
+    // Handle that stays safe to hold after this actor is destroyed
+    ActorHandle GetHandle() const { return mHandle; }
+
     // Components getter
     const std::vector<class Component*>& GetComponents() const { return mComponents; }
 
-    // Returns component of type T, or null if doesn't exist
+    // Returns component of type T, or null if doesn't exist.
+    // T must be a class that registers itself with RegisterComponent.
     template <typename T>
     T* GetComponent() const
     {
-        for (auto c : mComponents)
+        const size_t id = ComponentType::Id<T>();
+        if (id >= mComponentTable.size())
         {
-            T* t = dynamic_cast<T*>(c);
-            if (t != nullptr)
-            {
-                return t;
-            }
+            return nullptr;
         }
 
-        return nullptr;
+        return static_cast<T*>(mComponentTable[id]);
+    }
+
+    // Makes c the result of GetComponent<T>() (called from component constructors).
+    // The first component registered for a type wins.
+    template <typename T>
+    void RegisterComponent(T* c)
+    {
+        const size_t id = ComponentType::Id<T>();
+        if (id >= mComponentTable.size())
+        {
+            mComponentTable.resize(id + 1, nullptr);
+        }
+
+        if (!mComponentTable[id])
+        {
+            mComponentTable[id] = c;
+        }
     }
 
     // Game specific
@@ -79,9 +111,12 @@ public:
     virtual void OnVerticalCollision(float minOverlap, AABBColliderComponent* other);
     virtual void Kill();
 
-    const std::string& GetActorName() { return mActorName; }
+    const std::string& GetActorName() const { return mActorName; }
+    void SetActorName(const std::string& name);
 
-    bool mIsManageable = false;
+    // Manageable actors can be looked up and edited from the terminal
+    bool IsManageable() const { return mIsManageable; }
+    void SetManageable(bool manageable);
 
 protected:
     class Game* mGame;
@@ -96,11 +131,18 @@ protected:
 
     // Transform
     Vector2 mPosition;
+    Vector2 mPrevPosition;
+    bool mHasPrevPosition;
     Vector2 mScale;
     float mRotation;
 
     // Components
     std::vector<class Component*> mComponents;
+    // Components indexed by ComponentType id
+    std::vector<class Component*> mComponentTable;
+
+    // Colliders owned by this actor (kept in sync with the collision grid on move)
+    std::vector<class AABBColliderComponent*> mColliders;
 
     // Game specific
     bool mIsOnGround;
@@ -108,9 +150,23 @@ protected:
     std::string mActorName;
 
 private:
+    bool mIsManageable = false;
+
     friend class Component;
+    friend class AABBColliderComponent;
+    friend class Game;
+
+    // Registration in Game (owned by Game)
+    ActorHandle mHandle;
+    int mActorIndex = -1;
+    bool mIsPendingActor = false;
 
     // Adds component to Actor (this is automatically called
     // in the component constructor)
     void AddComponent(class Component* c);
+    void RemoveComponent(class Component* c);
+
+    // Tracks colliders so position changes can update the broadphase
+    void AddCollider(class AABBColliderComponent* collider);
+    void RemoveCollider(class AABBColliderComponent* collider);
 };
\ No newline at end of file
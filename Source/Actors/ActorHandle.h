@@ -0,0 +1,26 @@
+//
+// ActorHandle.h
+//
+
+#pragma once
+#include <cstdint>
+
+// Weak reference to an actor: an index into Game's actor slot table plus the
+// generation of the slot when the handle was taken. Once the actor is deleted
+// the slot's generation changes, so Game::GetActor returns null instead of a
+// dangling pointer.
+struct ActorHandle
+{
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool IsNull() const { return index == INVALID_INDEX; }
+
+    bool operator==(const ActorHandle& other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const ActorHandle& other) const { return !(*this == other); }
+};
@@ -11,7 +11,7 @@
 Block::Block(Game* game, const std::string& uniqueName, const std::string &texturePath, const bool isStatic, const bool isManageable)
         :Actor(game, uniqueName)
 {
-        mIsManageable = isManageable;
+        SetManageable(isManageable);
 
         new AnimatorComponent(this,
                 texturePath,
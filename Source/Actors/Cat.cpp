@@ -12,6 +12,7 @@
 #include "../Components/Physics/AABBColliderComponent.h"
 #include "../Components/ParticleSystemComponent.h"
 #include "../AudioSystem.h"
+#include "../Utils/Log.h"
 
 Cat::Cat(Game* game, const std::string& uniqueName, const float forwardSpeed, const float jumpSpeed)
         : Actor(game, uniqueName)
@@ -27,13 +28,13 @@ Cat::Cat(Game* game, const std::string& uniqueName, const float forwardSpeed, co
         "../Assets/Sprites/Cat/Cat.json",
         Game::TILE_SIZE,
         Game::TILE_SIZE);
-    mDrawComponent->AddAnimation("idle", {0});
-    mDrawComponent->AddAnimation("dead", {0});
-    mDrawComponent->AddAnimation("jump", {2,4,5,1,6,9,3,7});
-    mDrawComponent->AddAnimation("run", {10,16,18,14,19,20,21,22}); // Select a smooth subset for looping
+    mIdleAnim = mDrawComponent->AddAnimation("idle", {0});
+    mDeadAnim = mDrawComponent->AddAnimation("dead", {0});
+    mJumpAnim = mDrawComponent->AddAnimation("jump", {2,4,5,1,6,9,3,7});
+    mRunAnim = mDrawComponent->AddAnimation("run", {10,16,18,14,19,20,21,22}); // Select a smooth subset for looping
     mDrawComponent->SetAnimFPS(6.f); // base (jump speed)
 
-    mDrawComponent->SetAnimation("idle");
+    mDrawComponent->SetAnimation(mIdleAnim);
 
     mRigidBodyComponent = new RigidBodyComponent(this, 1.f, 5.f);
 
@@ -44,7 +45,7 @@ Cat::Cat(Game* game, const std::string& uniqueName, const float forwardSpeed, co
             Game::TILE_SIZE,
             ColliderLayer::Player);
 
-    mIsManageable = true;
+    SetManageable(true);
 }
 
 void Cat::Jump()
@@ -137,14 +138,14 @@ void Cat::OnUpdate(float deltaTime)
         {
             if (!mWalkingSfxPlaying)
             {
-                SDL_Log("[Cat] Start walking SFX (running=%d, onGround=%d)", (int)mIsRunning, (int)mIsOnGround);
+                LOG_DEBUG(Gameplay, "[Cat] Start walking SFX (running=%d, onGround=%d)", (int)mIsRunning, (int)mIsOnGround);
                 mGame->mAudio->PlaySound("Cat/Walking.wav", true);
                 mWalkingSfxPlaying = true;
             }
         }
         else if (mWalkingSfxPlaying)
         {
-            SDL_Log("[Cat] Stop walking SFX (running=%d, onGround=%d)", (int)mIsRunning, (int)mIsOnGround);
+            LOG_DEBUG(Gameplay, "[Cat] Stop walking SFX (running=%d, onGround=%d)", (int)mIsRunning, (int)mIsOnGround);
             mGame->mAudio->StopSound("Cat/Walking.wav");
             mWalkingSfxPlaying = false;
         }
@@ -161,18 +162,18 @@ void Cat::ManageAnimations()
         if (mIsRunning)
         {
             mDrawComponent->SetAnimFPS(10.f);
-            mDrawComponent->SetAnimation("run");
+            mDrawComponent->SetAnimation(mRunAnim);
         }
         else
         {
             mDrawComponent->SetAnimFPS(4.f);
-            mDrawComponent->SetAnimation("idle");
+            mDrawComponent->SetAnimation(mIdleAnim);
         }
     }
     else
     {
         mDrawComponent->SetAnimFPS(6.f);
-        mDrawComponent->SetAnimation("jump");
+        mDrawComponent->SetAnimation(mJumpAnim);
     }
 }
 
@@ -181,7 +182,7 @@ void Cat::Kill()
     if (mIsDead)
         return;
 
-    mDrawComponent->SetAnimation("dead");
+    mDrawComponent->SetAnimation(mDeadAnim);
     mIsDead = true;
     mRigidBodyComponent->SetEnabled(false);
     mColliderComponent->SetEnabled(false);
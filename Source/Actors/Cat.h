@@ -45,4 +45,10 @@ private:
     class RigidBodyComponent* mRigidBodyComponent;
     class AnimatorComponent* mDrawComponent;
     class AABBColliderComponent* mColliderComponent;
+
+    // Clip ids, so the per-tick animation switch skips the name lookup
+    int mIdleAnim = -1;
+    int mDeadAnim = -1;
+    int mJumpAnim = -1;
+    int mRunAnim = -1;
 };
\ No newline at end of file
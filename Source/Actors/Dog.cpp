@@ -23,9 +23,9 @@ Dog::Dog(Game* game, const std::string& uniqueName, float forwardSpeed, float de
             Game::TILE_SIZE,
             Game::TILE_SIZE);
 
-        mDrawComponent->AddAnimation("walk", {1, 2, 3});
-        mDrawComponent->AddAnimation("dead", {0});
-        mDrawComponent->SetAnimation("walk");
+        mWalkAnim = mDrawComponent->AddAnimation("walk", {1, 2, 3});
+        mDeadAnim = mDrawComponent->AddAnimation("dead", {0});
+        mDrawComponent->SetAnimation(mWalkAnim);
         mDrawComponent->SetAnimFPS(10.f);
 
         mRigidBodyComponent = new RigidBodyComponent(this);
@@ -46,7 +46,7 @@ Dog::Dog(Game* game, const std::string& uniqueName, float forwardSpeed, float de
 void Dog::Kill()
 {
     mIsDying = true;
-    mDrawComponent->SetAnimation("dead");
+    mDrawComponent->SetAnimation(mDeadAnim);
     mRigidBodyComponent->SetEnabled(false);
     mColliderComponent->SetEnabled(false);
 }
@@ -29,4 +29,8 @@ private:
     class RigidBodyComponent* mRigidBodyComponent;
     AABBColliderComponent* mColliderComponent;
     class AnimatorComponent* mDrawComponent;
+
+    // Clip ids returned by AddAnimation
+    int mWalkAnim = -1;
+    int mDeadAnim = -1;
 };
\ No newline at end of file
@@ -20,7 +20,7 @@ void Spawner::OnUpdate(float deltaTime)
         if (mGame->GetPlayer()->GetPosition().x < mSpawnDistance)
         {
                 auto* dog = new Dog(mGame, "Dog" + std::to_string(mGame->GetDogNum()));
-                dog->mIsManageable = true;
+                dog->SetManageable(true);
                 dog->SetPosition(GetPosition());
                 dog->GetComponent<AABBColliderComponent>()->SetEnabled(true);
                 mState = ActorState::Destroy;
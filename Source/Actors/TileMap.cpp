@@ -0,0 +1,103 @@
+//
+// TileMap.cpp
+//
+
+#include "TileMap.h"
+#include <algorithm>
+#include <cmath>
+#include "../Game.h"
+#include "../Components/Drawing/TileMapComponent.h"
+#include "../Components/Physics/AABBColliderComponent.h"
+
+TileMap::TileMap(Game* game, const std::string& uniqueName, const int width, const int height)
+        :Actor(game, uniqueName)
+        ,mWidth(width)
+        ,mHeight(height)
+        ,mTileSize(Game::TILE_SIZE)
+        ,mTiles(static_cast<size_t>(width) * height, EMPTY_TILE)
+{
+    mTileMapComponent = new TileMapComponent(this);
+
+    // Never collides by itself (disabled colliders are skipped by the broadphase);
+    // it only gives tile hits a Blocks-layer "other" for the collision callbacks
+    mTileCollider = new AABBColliderComponent(this, 0, 0, mTileSize, mTileSize, ColliderLayer::Blocks, true);
+    mTileCollider->SetEnabled(false);
+
+    mGame->SetTileMap(this);
+}
+
+TileMap::~TileMap()
+{
+    if (mGame->GetTileMap() == this)
+    {
+        mGame->SetTileMap(nullptr);
+    }
+}
+
+int TileMap::GetTile(const int col, const int row) const
+{
+    if (col < 0 || col >= mWidth || row < 0 || row >= mHeight)
+    {
+        return EMPTY_TILE;
+    }
+
+    return mTiles[row * mWidth + col];
+}
+
+void TileMap::SetTile(const int col, const int row, const int tileID)
+{
+    if (col < 0 || col >= mWidth || row < 0 || row >= mHeight)
+    {
+        return;
+    }
+
+    mTiles[row * mWidth + col] = static_cast<int16_t>(tileID);
+    mTileMapComponent->MarkTileDirty(col, row);
+}
+
+void TileMap::SetTileTexture(const int tileID, Texture* texture)
+{
+    if (tileID < 0)
+    {
+        return;
+    }
+
+    if (tileID >= static_cast<int>(mTileTextures.size()))
+    {
+        mTileTextures.resize(tileID + 1, nullptr);
+    }
+
+    mTileTextures[tileID] = texture;
+
+    // Baked meshes are grouped by atlas page and hold the tile UVs
+    for (int row = 0; row < mHeight; ++row)
+    {
+        for (int col = 0; col < mWidth; col += TileMapComponent::CHUNK_SIZE)
+        {
+            mTileMapComponent->MarkTileDirty(col, row);
+        }
+    }
+}
+
+Texture* TileMap::GetTileTexture(const int tileID) const
+{
+    if (tileID < 0 || tileID >= static_cast<int>(mTileTextures.size()))
+    {
+        return nullptr;
+    }
+
+    return mTileTextures[tileID];
+}
+
+bool TileMap::GetCellRange(const Vector2& min, const Vector2& max, int& minCol, int& minRow, int& maxCol, int& maxRow) const
+{
+    const float invTileSize = 1.0f / static_cast<float>(mTileSize);
+
+    // Max edge is exclusive, same as the collision grid
+    minCol = std::max(0, static_cast<int>(std::floor((min.x - mPosition.x) * invTileSize)));
+    minRow = std::max(0, static_cast<int>(std::floor((min.y - mPosition.y) * invTileSize)));
+    maxCol = std::min(mWidth - 1, static_cast<int>(std::ceil((max.x - mPosition.x) * invTileSize)) - 1);
+    maxRow = std::min(mHeight - 1, static_cast<int>(std::ceil((max.y - mPosition.y) * invTileSize)) - 1);
+
+    return minCol <= maxCol && minRow <= maxRow;
+}
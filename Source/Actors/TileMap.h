@@ -0,0 +1,80 @@
+//
+// TileMap.h
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Actor.h"
+
+// Static level geometry. Plain tiles are stored as IDs in a flat grid instead of
+// one Block actor each; they are drawn by a single TileMapComponent and
+// collided against by indexing the grid cells a box overlaps.
+class TileMap : public Actor
+{
+public:
+    static const int EMPTY_TILE = -1;
+
+    TileMap(class Game* game, const std::string& uniqueName, int width, int height);
+    ~TileMap() override;
+
+    int GetWidth() const { return mWidth; }
+    int GetHeight() const { return mHeight; }
+    int GetTileSize() const { return mTileSize; }
+
+    int GetTile(int col, int row) const;
+    void SetTile(int col, int row, int tileID);
+    bool IsSolid(int col, int row) const { return GetTile(col, row) != EMPTY_TILE; }
+
+    // Texture used for every tile with this ID
+    void SetTileTexture(int tileID, class Texture* texture);
+    class Texture* GetTileTexture(int tileID) const;
+
+    // Collider reported as "other" to actors that hit a tile
+    class AABBColliderComponent* GetTileCollider() const { return mTileCollider; }
+
+    // Calls fn(tileMin, tileMax) for every solid tile whose cell overlaps [min, max)
+    template <typename Fn>
+    void ForEachSolidTile(const Vector2& min, const Vector2& max, Fn&& fn) const
+    {
+        int minCol, minRow, maxCol, maxRow;
+        if (!GetCellRange(min, max, minCol, minRow, maxCol, maxRow))
+        {
+            return;
+        }
+
+        for (int row = minRow; row <= maxRow; ++row)
+        {
+            for (int col = minCol; col <= maxCol; ++col)
+            {
+                if (mTiles[row * mWidth + col] != EMPTY_TILE)
+                {
+                    const Vector2 tileMin = GetTilePosition(col, row);
+                    fn(tileMin, tileMin + Vector2(mTileSize, mTileSize));
+                }
+            }
+        }
+    }
+
+    // World position of a tile's top-left corner
+    Vector2 GetTilePosition(int col, int row) const
+    {
+        return Vector2(mPosition.x + static_cast<float>(col * mTileSize),
+                       mPosition.y + static_cast<float>(row * mTileSize));
+    }
+
+    // Clamped range of cells overlapped by [min, max); false if it misses the map
+    bool GetCellRange(const Vector2& min, const Vector2& max, int& minCol, int& minRow, int& maxCol, int& maxRow) const;
+
+private:
+    int mWidth;
+    int mHeight;
+    int mTileSize;
+
+    std::vector<int16_t> mTiles;
+    std::vector<class Texture*> mTileTextures;
+
+    class AABBColliderComponent* mTileCollider;
+    class TileMapComponent* mTileMapComponent;
+};
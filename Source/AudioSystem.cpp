@@ -1,7 +1,8 @@
 #include "AudioSystem.h"
+#include "Utils/Log.h"
 #include <SDL.h>
 
-AudioSystem::AudioSystem() : mNumChannels(16) {}
+AudioSystem::AudioSystem() : mNumChannels(16), mIsInitialized(false) {}
 
 AudioSystem::~AudioSystem() { Shutdown(); }
 
@@ -10,21 +11,25 @@ bool AudioSystem::Initialize()
     int flags = MIX_INIT_MP3 | MIX_INIT_OGG;
     if ((Mix_Init(flags) & flags) == 0)
     {
-        SDL_Log("Mix_Init failed: %s", Mix_GetError());
+        LOG_ERROR(Audio, "Mix_Init failed: %s", Mix_GetError());
     }
 
     if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0)
     {
-        SDL_Log("Mix_OpenAudio failed: %s", Mix_GetError());
+        LOG_ERROR(Audio, "Mix_OpenAudio failed: %s", Mix_GetError());
         return false;
     }
 
     Mix_AllocateChannels(mNumChannels);
+    mIsInitialized = true;
     return true;
 }
 
 void AudioSystem::Shutdown()
 {
+    if (!mIsInitialized) return;
+    mIsInitialized = false;
+
     for (auto &kv : mChunkCache)
     {
         if (kv.second)
@@ -54,7 +59,7 @@ Mix_Chunk* AudioSystem::LoadChunk(const std::string& soundName)
     Mix_Chunk* chunk = Mix_LoadWAV(fullPath.c_str());
     if (!chunk)
     {
-        SDL_Log("Failed to load sound '%s': %s", fullPath.c_str(), Mix_GetError());
+        LOG_WARN(Audio, "Failed to load sound '%s': %s", fullPath.c_str(), Mix_GetError());
         return nullptr;
     }
     mChunkCache.emplace(soundName, chunk);
@@ -92,12 +97,12 @@ void AudioSystem::PlaySound(const std::string& soundName, bool looping)
         ch = Mix_PlayChannel(steal, chunk, loops);
         if (ch == -1)
         {
-            SDL_Log("Failed to play sound '%s': %s", soundName.c_str(), Mix_GetError());
+            LOG_WARN(Audio, "Failed to play sound '%s': %s", soundName.c_str(), Mix_GetError());
         }
     }
     else
     {
-        SDL_Log("[Audio] Playing '%s' on channel %d (loops=%d)", soundName.c_str(), ch, loops);
+        LOG_DEBUG(Audio, "Playing '%s' on channel %d (loops=%d)", soundName.c_str(), ch, loops);
     }
 }
 
@@ -124,7 +129,7 @@ void AudioSystem::StopSound(const std::string& soundName)
             ++stopped;
         }
     }
-    SDL_Log("[Audio] Stop '%s' on %d channel(s)", soundName.c_str(), stopped);
+    LOG_DEBUG(Audio, "Stop '%s' on %d channel(s)", soundName.c_str(), stopped);
 }
 
 void AudioSystem::PauseSound(const std::string& soundName)
@@ -140,7 +145,7 @@ void AudioSystem::PauseSound(const std::string& soundName)
             ++paused;
         }
     }
-    SDL_Log("[Audio] Pause '%s' on %d channel(s)", soundName.c_str(), paused);
+    LOG_DEBUG(Audio, "Pause '%s' on %d channel(s)", soundName.c_str(), paused);
 }
 
 void AudioSystem::ResumeSound(const std::string& soundName)
@@ -156,5 +161,5 @@ void AudioSystem::ResumeSound(const std::string& soundName)
             ++resumed;
         }
     }
-    SDL_Log("[Audio] Resume '%s' on %d channel(s)", soundName.c_str(), resumed);
+    LOG_DEBUG(Audio, "Resume '%s' on %d channel(s)", soundName.c_str(), resumed);
 }
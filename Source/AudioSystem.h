@@ -6,17 +6,17 @@
 class AudioSystem {
 public:
     AudioSystem();
-    ~AudioSystem();
+    virtual ~AudioSystem();
 
-    bool Initialize();
-    void Shutdown();
-    void Update();
+    virtual bool Initialize();
+    virtual void Shutdown();
+    virtual void Update();
 
-    void PlaySound(const std::string& soundName, bool looping);
-    void StopSound(const std::string& soundName);
-    void PauseSound(const std::string& soundName);
-    void ResumeSound(const std::string& soundName);
-    void SetVolume(const std::string& soundName, int volume /*0-128*/);
+    virtual void PlaySound(const std::string& soundName, bool looping);
+    virtual void StopSound(const std::string& soundName);
+    virtual void PauseSound(const std::string& soundName);
+    virtual void ResumeSound(const std::string& soundName);
+    virtual void SetVolume(const std::string& soundName, int volume /*0-128*/);
 
 private:
     Mix_Chunk* LoadChunk(const std::string& soundName);
@@ -24,4 +24,19 @@ private:
 
     std::unordered_map<std::string, Mix_Chunk*> mChunkCache;
     int mNumChannels;
+    bool mIsInitialized;
+};
+
+// Silent stand-in used by headless runs (no mixer device is opened)
+class NullAudioSystem : public AudioSystem {
+public:
+    bool Initialize() override { return true; }
+    void Shutdown() override {}
+    void Update() override {}
+
+    void PlaySound(const std::string& soundName, bool looping) override {}
+    void StopSound(const std::string& soundName) override {}
+    void PauseSound(const std::string& soundName) override {}
+    void ResumeSound(const std::string& soundName) override {}
+    void SetVolume(const std::string& soundName, int volume) override {}
 };
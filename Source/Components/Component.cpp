@@ -8,11 +8,13 @@
 
 #include "Component.h"
 #include "../Actors/Actor.h"
+#include "../Utils/SceneArena.h"
 
 Component::Component(Actor* owner, int updateOrder)
           :mOwner(owner)
           ,mUpdateOrder(updateOrder)
           ,mIsEnabled(true)
+          ,mUpdatesWithOwner(true)
 {
     // Add to actor's vector of components
     mOwner->AddComponent(this);
@@ -20,6 +22,17 @@ Component::Component(Actor* owner, int updateOrder)
 
 Component::~Component()
 {
+    mOwner->RemoveComponent(this);
+}
+
+void* Component::operator new(size_t size)
+{
+    return SceneArena::Get().Allocate(size);
+}
+
+void Component::operator delete(void* p, size_t size)
+{
+    SceneArena::Get().Free(p);
 }
 
 void Component::Update(float deltaTime)
@@ -34,6 +47,11 @@ void Component::DebugDraw(class Renderer* renderer)
 {
 }
 
+bool Component::ShouldUpdate() const
+{
+    return mIsEnabled && mOwner->GetState() == ActorState::Active && !mOwner->IsPendingActor();
+}
+
 class Game* Component::GetGame() const
 {
     return mOwner->GetGame();
@@ -19,6 +19,10 @@ public:
     Component(class Actor* owner, int updateOrder = 100);
     // Destructor
     virtual ~Component();
+
+    // Instances are allocated from the SceneArena (pooled types override these)
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size);
     // Update this component by delta time
     virtual void Update(float deltaTime);
     // Process input for this component (if needed)
@@ -33,6 +37,12 @@ public:
     void SetEnabled(const bool enabled) { mIsEnabled = enabled; };
     bool IsEnabled() const { return mIsEnabled; };
 
+    // Whether Actor::Update ticks this component. Pooled types are ticked by
+    // their own pass in Game::UpdateActors instead.
+    bool UpdatesWithOwner() const { return mUpdatesWithOwner; }
+    // Enabled, and owned by an active actor that has finished spawning
+    bool ShouldUpdate() const;
+
     virtual void OnScaleChanged() {}
 
 protected:
@@ -42,4 +52,5 @@ protected:
     int mUpdateOrder;
     // Is component enabled
     bool mIsEnabled;
+    bool mUpdatesWithOwner;
 };
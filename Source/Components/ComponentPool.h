@@ -0,0 +1,113 @@
+//
+// ComponentPool.h
+//
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Contiguous storage for one component type. Pooled component classes route
+// their class-level operator new/delete here, so every instance of the type
+// lives in a few large chunks and an update pass can walk them in address
+// order instead of chasing pointers through each actor.
+template <typename T, size_t ChunkSize = 256>
+class ComponentPool
+{
+public:
+    static ComponentPool& Get()
+    {
+        static ComponentPool pool;
+        return pool;
+    }
+
+    void* Allocate(size_t size)
+    {
+        // Subclasses with extra members don't fit in a slot
+        if (size != sizeof(T))
+        {
+            return ::operator new(size);
+        }
+
+        if (mFreeSlots.empty())
+        {
+            AddChunk();
+        }
+
+        const size_t slot = mFreeSlots.back();
+        mFreeSlots.pop_back();
+
+        Chunk& chunk = *mChunks[slot / ChunkSize];
+        chunk.live[slot % ChunkSize] = true;
+        return chunk.Slot(slot % ChunkSize);
+    }
+
+    void Free(void* p, size_t size)
+    {
+        if (!p)
+        {
+            return;
+        }
+
+        if (size != sizeof(T))
+        {
+            ::operator delete(p);
+            return;
+        }
+
+        auto* bytes = static_cast<unsigned char*>(p);
+        for (size_t c = 0; c < mChunks.size(); ++c)
+        {
+            Chunk& chunk = *mChunks[c];
+            if (bytes >= chunk.storage && bytes < chunk.storage + sizeof(chunk.storage))
+            {
+                const size_t index = static_cast<size_t>(bytes - chunk.storage) / sizeof(T);
+                chunk.live[index] = false;
+                mFreeSlots.emplace_back(c * ChunkSize + index);
+                return;
+            }
+        }
+    }
+
+    // Calls fn on every live component, in memory order. Components created
+    // during the pass may or may not be visited.
+    template <typename Fn>
+    void ForEach(Fn&& fn)
+    {
+        for (size_t c = 0; c < mChunks.size(); ++c)
+        {
+            for (size_t i = 0; i < ChunkSize; ++i)
+            {
+                if (mChunks[c]->live[i])
+                {
+                    fn(static_cast<T*>(mChunks[c]->Slot(i)));
+                }
+            }
+        }
+    }
+
+private:
+    struct Chunk
+    {
+        alignas(T) unsigned char storage[ChunkSize * sizeof(T)];
+        bool live[ChunkSize] = {};
+
+        void* Slot(size_t i) { return storage + i * sizeof(T); }
+    };
+
+    void AddChunk()
+    {
+        const size_t base = mChunks.size() * ChunkSize;
+        mChunks.emplace_back(std::make_unique<Chunk>());
+
+        // Hand out low addresses first
+        for (size_t i = ChunkSize; i-- > 0;)
+        {
+            mFreeSlots.emplace_back(base + i);
+        }
+    }
+
+    std::vector<std::unique_ptr<Chunk>> mChunks;
+    std::vector<size_t> mFreeSlots;
+};
@@ -0,0 +1,23 @@
+//
+// ComponentType.h
+//
+
+#pragma once
+#include <cstddef>
+
+// Compile-time component type IDs. Each component class gets a small dense
+// index the first time ComponentType::Id<T>() is instantiated, which Actor
+// uses to index its component lookup table without RTTI.
+class ComponentType
+{
+public:
+    template <typename T>
+    static size_t Id()
+    {
+        static const size_t id = sNextId++;
+        return id;
+    }
+
+private:
+    static inline size_t sNextId = 0;
+};
@@ -5,8 +5,10 @@
 #include "AnimatorComponent.h"
 #include "../../Actors/Actor.h"
 #include "../../Game.h"
-#include "../../Json.h"
-#include <fstream>
+#include "SpriteSheet.h"
+#include "../../Utils/Profiler.h"
+#include <cassert>
+#include "../ComponentPool.h"
 
 AnimatorComponent::AnimatorComponent(class Actor* owner, const std::string &texPath, const std::string &dataPath,
                                      int width, int height, const float xOffset, const float yOffset,  int drawOrder)
@@ -19,59 +21,27 @@ AnimatorComponent::AnimatorComponent(class Actor* owner, const std::string &texP
         ,mXOffset(xOffset)
         ,mYOffset(yOffset)
 {
+    mOwner->RegisterComponent(this);
+
     mSpriteTexture = owner->GetGame()->GetRenderer()->GetTexture(texPath);
     assert(mSpriteTexture != nullptr);
 
     if (!dataPath.empty())
-        LoadSpriteSheetData(dataPath);
+        mSpriteSheet = SpriteSheet::Load(dataPath);
 }
 
 AnimatorComponent::~AnimatorComponent()
 {
-    mAnimations.clear();
-    mSpriteSheetData.clear();
-}
-
-bool AnimatorComponent::LoadSpriteSheetData(const std::string& dataPath)
-{
-    // Load sprite sheet data and return false if it fails
-    std::ifstream spriteSheetFile(dataPath);
-
-    if (!spriteSheetFile.is_open()) {
-        SDL_Log("Failed to open sprite sheet data file: %s", dataPath.c_str());
-        return false;
-    }
-
-    nlohmann::json spriteSheetData = nlohmann::json::parse(spriteSheetFile);
-
-    if (spriteSheetData.is_null()) {
-        SDL_Log("Failed to parse sprite sheet data file: %s", dataPath.c_str());
-        return false;
-    }
-
-    auto textureWidth = static_cast<float>(spriteSheetData["meta"]["size"]["w"].get<int>());
-    auto textureHeight = static_cast<float>(spriteSheetData["meta"]["size"]["h"].get<int>());
-
-    for(const auto& frame : spriteSheetData["frames"]) {
-
-        int x = frame["frame"]["x"].get<int>();
-        int y = frame["frame"]["y"].get<int>();
-        int w = frame["frame"]["w"].get<int>();
-        int h = frame["frame"]["h"].get<int>();
-
-        mSpriteSheetData.emplace_back(static_cast<float>(x)/textureWidth, static_cast<float>(y)/textureHeight,
-                                      static_cast<float>(w)/textureWidth, static_cast<float>(h)/textureHeight);
-    }
-
-    return true;
 }
 
 void AnimatorComponent::Draw(Renderer* renderer)
 {
+    PROFILE_SCOPE("AnimatorComponent::Draw");
+
     if (!mIsVisible)
         return;
 
-    Vector2 position = mOwner->GetPosition();
+    Vector2 position = mOwner->GetRenderPosition();
     position.x += mXOffset;
     position.y += mYOffset;
     float rotation = mOwner->GetRotation();
@@ -84,14 +54,13 @@ void AnimatorComponent::Draw(Renderer* renderer)
 
     Vector4 texRect(0.0f, 0.0f, 1.0f, 1.0f);
 
-    if (mAnimations.count(mAnimName) > 0)
+    if (mClip)
     {
         const int currentFrame = static_cast<int>(mAnimTimer);
-        const int animIndex = mAnimations[mAnimName][currentFrame];
-        texRect = mSpriteSheetData[animIndex];
+        texRect = mSpriteSheet->GetFrame(mClip->frames[currentFrame]);
     }
 
-    Vector2 cameraPos = mOwner->GetGame()->GetCameraPos();
+    Vector2 cameraPos = mOwner->GetGame()->GetRenderCameraPos();
 
     bool flip = false;
 
@@ -100,26 +69,63 @@ void AnimatorComponent::Draw(Renderer* renderer)
     renderer->DrawTexture(position, size, rotation, color, mSpriteTexture, texRect, cameraPos, flip, textureFactor);
 }
 
+bool AnimatorComponent::GetWorldBounds(Vector2& outMin, Vector2& outMax) const
+{
+    Vector2 position = mOwner->GetRenderPosition();
+    position.x += mXOffset;
+    position.y += mYOffset;
+
+    Vector2 size(static_cast<float>(mWidth), static_cast<float>(mHeight));
+    size.x *= GetOwner()->GetScale().x;
+    size.y *= GetOwner()->GetScale().y;
+
+    GetCenteredBounds(position, size, mOwner->GetRotation(), outMin, outMax);
+    return true;
+}
+
 void AnimatorComponent::Update(float deltaTime)
 {
-    if (mIsPaused || mAnimations.empty() || mAnimations.count(mAnimName) == 0)
+    PROFILE_SCOPE("AnimatorComponent::Update");
+
+    if (mIsPaused || !mClip)
     {
         return;
     }
 
     mAnimTimer += mAnimFPS * deltaTime;
 
-    if (mAnimTimer >= mAnimations[mAnimName].size())
+    if (mAnimTimer >= mClip->frames.size())
         mAnimTimer = 0.0f;
 }
 
 void AnimatorComponent::SetAnimation(const std::string& name)
 {
-    mAnimName = name;
+    mClip = mSpriteSheet ? mSpriteSheet->FindClip(name) : nullptr;
+    Update(0.0f);
+}
+
+void AnimatorComponent::SetAnimation(const int clipId)
+{
+    mClip = mSpriteSheet ? mSpriteSheet->GetClip(clipId) : nullptr;
     Update(0.0f);
 }
 
-void AnimatorComponent::AddAnimation(const std::string& name, const std::vector<int>& spriteNums)
+int AnimatorComponent::AddAnimation(const std::string& name, std::initializer_list<int> spriteNums)
 {
-    mAnimations.emplace(name, spriteNums);
-}
\ No newline at end of file
+    return mSpriteSheet ? mSpriteSheet->AddClip(name, spriteNums) : -1;
+}
+
+int AnimatorComponent::AddAnimation(const std::string& name, const std::vector<int>& spriteNums)
+{
+    return mSpriteSheet ? mSpriteSheet->AddClip(name, spriteNums) : -1;
+}
+
+void* AnimatorComponent::operator new(size_t size)
+{
+    return ComponentPool<AnimatorComponent>::Get().Allocate(size);
+}
+
+void AnimatorComponent::operator delete(void* p, size_t size)
+{
+    ComponentPool<AnimatorComponent>::Get().Free(p, size);
+}
@@ -4,7 +4,8 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <initializer_list>
+#include <vector>
 #include "DrawComponent.h"
 
 class AnimatorComponent : public DrawComponent {
@@ -14,7 +15,12 @@ public:
             int width, int height, const float xOffset = 0.f, const float yOffset = 0.f, int drawOrder = 100);
     ~AnimatorComponent() override;
 
+    // Instances are allocated from ComponentPool<AnimatorComponent>
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size);
+
     void Draw(Renderer* renderer) override;
+    bool GetWorldBounds(Vector2& outMin, Vector2& outMax) const override;
     void Update(float deltaTime) override;
 
     // Use to change the FPS of the animation
@@ -22,27 +28,25 @@ public:
 
     // Set the current active animation
     void SetAnimation(const std::string& name);
+    void SetAnimation(int clipId);
 
     // Use to pause/unpause the animation
     void SetIsPaused(bool pause) { mIsPaused = pause; }
 
-    // Add an animation of the corresponding name to the animation map
-    void AddAnimation(const std::string& name, const std::vector<int>& images);
+    // Add an animation of the corresponding name to the sprite sheet's shared clips.
+    // Returns the clip id (or -1 without a sprite sheet).
+    int AddAnimation(const std::string& name, std::initializer_list<int> images);
+    int AddAnimation(const std::string& name, const std::vector<int>& images);
 
 private:
-    bool LoadSpriteSheetData(const std::string& dataPath);
-
     // Sprite sheet texture
     class Texture* mSpriteTexture;
 
-    // Vector of sprites
-    std::vector<Vector4> mSpriteSheetData;
-
-    // Map of animation name to vector of textures corresponding to the animation
-    std::unordered_map<std::string, std::vector<int>> mAnimations;
+    // Shared frame table and clips (null when the texture is drawn whole)
+    class SpriteSheet* mSpriteSheet = nullptr;
 
-    // Name of current animation
-    std::string mAnimName;
+    // Current animation
+    const struct AnimationClip* mClip = nullptr;
 
     // Tracks current elapsed time in animation
     float mAnimTimer = 0.0f;
@@ -12,6 +12,10 @@ DrawComponent::DrawComponent(class Actor *owner, int drawOrder)
         , mIsVisible(true)
         , mColor(Vector3::One)
 {
+    // Drawing doesn't tick; animated subclasses have their own pass
+    mUpdatesWithOwner = false;
+
+    mOwner->RegisterComponent(this);
     mOwner->GetGame()->AddDrawable(this);
 }
 
@@ -24,3 +28,17 @@ void DrawComponent::Draw(Renderer *renderer)
 {
 
 }
+
+void DrawComponent::GetCenteredBounds(const Vector2 &center, const Vector2 &size, float rotation,
+                                      Vector2 &outMin, Vector2 &outMax)
+{
+    Vector2 halfSize(Math::Abs(size.x) * 0.5f, Math::Abs(size.y) * 0.5f);
+    if (!Math::NearlyZero(rotation))
+    {
+        const float radius = halfSize.Length();
+        halfSize = Vector2(radius, radius);
+    }
+
+    outMin = center - halfSize;
+    outMax = center + halfSize;
+}
@@ -18,13 +18,25 @@ public:
     ~DrawComponent();
 
     virtual void Draw(Renderer* renderer);
+
+    // World-space box covered by this drawable, used by Game to cull it against
+    // the camera. Returns false when there is no meaningful box, so it's always drawn.
+    virtual bool GetWorldBounds(Vector2& outMin, Vector2& outMax) const { return false; }
     int GetDrawOrder() const { return mDrawOrder; }
 
     void SetVisible(bool visible) { mIsVisible = visible; }
     void SetColor(const Vector3& color) { mColor = color; }
 
 protected:
+    friend class Game;
+
+    // Box around a sprite centered at center; rotated sprites get the box of their circumcircle
+    static void GetCenteredBounds(const Vector2& center, const Vector2& size, float rotation,
+                                  Vector2& outMin, Vector2& outMax);
+
     int mDrawOrder;
+    // Slot in Game's draw layer (-1 when not registered)
+    int mDrawIndex = -1;
     bool mIsVisible = true;
     Vector3 mColor;
 };
@@ -13,7 +13,7 @@ RectComponent::RectComponent(class Actor* owner, int width, int height, Renderer
     , mWidth(width)
     , mHeight(height)
 {
-
+    mOwner->RegisterComponent(this);
 }
 
 RectComponent::~RectComponent()
@@ -25,7 +25,13 @@ void RectComponent::Draw(class Renderer *renderer)
 {
     if(mIsVisible)
     {
-        renderer->DrawRect(mOwner->GetPosition(), Vector2(mWidth, mHeight), mOwner->GetRotation(),
-                           mColor, GetGame()->GetCameraPos(), mMode);
+        renderer->DrawRect(mOwner->GetRenderPosition(), Vector2(mWidth, mHeight), mOwner->GetRotation(),
+                           mColor, GetGame()->GetRenderCameraPos(), mMode);
     }
-}
\ No newline at end of file
+}
+
+bool RectComponent::GetWorldBounds(Vector2 &outMin, Vector2 &outMax) const
+{
+    GetCenteredBounds(mOwner->GetRenderPosition(), Vector2(mWidth, mHeight), mOwner->GetRotation(), outMin, outMax);
+    return true;
+}
@@ -14,6 +14,7 @@ public:
     ~RectComponent();
 
     void Draw(class Renderer* renderer) override;
+    bool GetWorldBounds(Vector2& outMin, Vector2& outMax) const override;
 
 private:
     int mWidth;
@@ -0,0 +1,100 @@
+//
+// SpriteSheet.cpp
+//
+
+#include "SpriteSheet.h"
+#include <fstream>
+#include <memory>
+#include <SDL.h>
+#include "../../Json.h"
+#include "../../Utils/Log.h"
+
+SpriteSheet::SpriteSheet(std::vector<Vector4> frames)
+    : mFrames(std::move(frames))
+{
+}
+
+SpriteSheet* SpriteSheet::Load(const std::string& dataPath)
+{
+    static std::unordered_map<std::string, std::unique_ptr<SpriteSheet>> sheets;
+
+    auto iter = sheets.find(dataPath);
+    if (iter != sheets.end())
+    {
+        return iter->second.get();
+    }
+
+    // Load sprite sheet data and return null if it fails
+    std::ifstream spriteSheetFile(dataPath);
+
+    if (!spriteSheetFile.is_open()) {
+        LOG_ERROR(Render, "Failed to open sprite sheet data file: %s", dataPath.c_str());
+        return nullptr;
+    }
+
+    nlohmann::json spriteSheetData = nlohmann::json::parse(spriteSheetFile);
+
+    if (spriteSheetData.is_null()) {
+        LOG_ERROR(Render, "Failed to parse sprite sheet data file: %s", dataPath.c_str());
+        return nullptr;
+    }
+
+    auto textureWidth = static_cast<float>(spriteSheetData["meta"]["size"]["w"].get<int>());
+    auto textureHeight = static_cast<float>(spriteSheetData["meta"]["size"]["h"].get<int>());
+
+    std::vector<Vector4> frames;
+    for(const auto& frame : spriteSheetData["frames"]) {
+
+        int x = frame["frame"]["x"].get<int>();
+        int y = frame["frame"]["y"].get<int>();
+        int w = frame["frame"]["w"].get<int>();
+        int h = frame["frame"]["h"].get<int>();
+
+        frames.emplace_back(static_cast<float>(x)/textureWidth, static_cast<float>(y)/textureHeight,
+                            static_cast<float>(w)/textureWidth, static_cast<float>(h)/textureHeight);
+    }
+
+    auto* sheet = new SpriteSheet(std::move(frames));
+    sheets.emplace(dataPath, std::unique_ptr<SpriteSheet>(sheet));
+    return sheet;
+}
+
+int SpriteSheet::AddClip(const std::string& name, std::initializer_list<int> frames)
+{
+    return AddClip(name, frames.begin(), frames.end());
+}
+
+int SpriteSheet::AddClip(const std::string& name, const std::vector<int>& frames)
+{
+    return AddClip(name, frames.data(), frames.data() + frames.size());
+}
+
+int SpriteSheet::AddClip(const std::string& name, const int* first, const int* last)
+{
+    auto iter = mClipIds.find(name);
+    if (iter != mClipIds.end())
+    {
+        return iter->second;
+    }
+
+    const int id = static_cast<int>(mClips.size());
+    mClips.push_back(AnimationClip{id, std::vector<int>(first, last)});
+    mClipIds.emplace(name, id);
+    return id;
+}
+
+const AnimationClip* SpriteSheet::GetClip(const int id) const
+{
+    if (id < 0 || id >= static_cast<int>(mClips.size()))
+    {
+        return nullptr;
+    }
+
+    return &mClips[id];
+}
+
+const AnimationClip* SpriteSheet::FindClip(const std::string& name) const
+{
+    auto iter = mClipIds.find(name);
+    return iter != mClipIds.end() ? &mClips[iter->second] : nullptr;
+}
@@ -0,0 +1,56 @@
+//
+// SpriteSheet.h
+//
+
+#pragma once
+
+#include <deque>
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../../Math.h"
+
+// Named sequence of frame indices into a sprite sheet
+struct AnimationClip
+{
+    int id;
+    std::vector<int> frames;
+};
+
+// Frame rectangles parsed once from a sprite sheet's JSON data file, plus the
+// animation clips defined on it. Sheets are cached by path and shared by every
+// AnimatorComponent that uses them, so only the first instance pays for parsing.
+class SpriteSheet
+{
+public:
+    // Returns the cached sheet for dataPath, parsing it on first use (null on failure)
+    static SpriteSheet* Load(const std::string& dataPath);
+
+    int GetNumFrames() const { return static_cast<int>(mFrames.size()); }
+    // Texture rect of a frame (normalized x, y, w, h)
+    const Vector4& GetFrame(int index) const
+    {
+        return index >= 0 && index < GetNumFrames() ? mFrames[index] : Vector4::UnitRect;
+    }
+
+    // Registers a clip and returns its id. Defining a name again returns the
+    // existing clip, so every instance of an actor can declare its clips.
+    int AddClip(const std::string& name, std::initializer_list<int> frames);
+    int AddClip(const std::string& name, const std::vector<int>& frames);
+
+    const AnimationClip* GetClip(int id) const;
+    const AnimationClip* FindClip(const std::string& name) const;
+
+private:
+    explicit SpriteSheet(std::vector<Vector4> frames);
+
+    int AddClip(const std::string& name, const int* first, const int* last);
+
+    // Frame table (never changes after loading)
+    std::vector<Vector4> mFrames;
+
+    // Clips are never removed; a deque keeps pointers to them stable
+    std::deque<AnimationClip> mClips;
+    std::unordered_map<std::string, int> mClipIds;
+};
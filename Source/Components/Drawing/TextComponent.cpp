@@ -8,30 +8,32 @@
 
 TextComponent::TextComponent(Actor *owner, const std::string &text, const Vector3 &color, int size) : DrawComponent(owner, 101)
 {
-    // Generate a texture from text
-    mTexture = owner->GetGame()
-                    ->mUiFont
-                    ->RenderText(text, color, size);
+    mOwner->RegisterComponent(this);
 
     mColor = color;
     mText = text;
+    mPointSize = size;
 
-    // Use texture size for drawing
-    mSize = Vector2(mTexture->GetWidth(), mTexture->GetHeight());
+    // Headless runs have no font loaded
+    mFont = owner->GetGame()->mUiFont;
+    if (!mFont)
+        return;
+
+    mSize = mFont->MeasureText(text, size);
 }
 
 void TextComponent::Draw(Renderer* renderer)
 {
-    if (!mTexture) return;
-
-    Vector2 worldPos = mOwner->GetPosition();
-    renderer->DrawTexture(
-        worldPos,
-        mSize,
-        0.0f,
-        mColor,
-        mTexture,
-        Vector4::UnitRect,
-        mOwner->GetGame()->GetCameraPos()
-    );
+    if (!mFont) return;
+
+    // Text is centered on the owner, like the sprite it replaces
+    const Vector2 worldPos = mOwner->GetRenderPosition();
+    mFont->DrawText(renderer, mText, worldPos - mSize * 0.5f, mColor, mPointSize,
+                    mOwner->GetGame()->GetRenderCameraPos());
+}
+
+bool TextComponent::GetWorldBounds(Vector2& outMin, Vector2& outMax) const
+{
+    GetCenteredBounds(mOwner->GetRenderPosition(), mSize, 0.0f, outMin, outMax);
+    return true;
 }
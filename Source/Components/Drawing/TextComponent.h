@@ -3,25 +3,20 @@
 //
 
 #pragma once
+#include <memory>
 #include "DrawComponent.h"
 
-class Texture;
-
 class TextComponent : public DrawComponent
 {
 public:
     TextComponent(Actor* owner, const std::string& text, const Vector3& color, int size);
 
-    ~TextComponent() override
-    {
-        if (mTexture)
-            delete mTexture;
-    }
-
     void Draw(Renderer* renderer) override;
+    bool GetWorldBounds(Vector2& outMin, Vector2& outMax) const override;
 
 private:
-    Texture* mTexture = nullptr;
+    std::shared_ptr<class Font> mFont;
+    int mPointSize;
     Vector2 mSize;
     std::string mText;
     Vector3 mColor;
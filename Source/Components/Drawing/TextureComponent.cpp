@@ -18,6 +18,8 @@ TextureComponent::TextureComponent(class Actor* owner, const std::string& texPat
     , mHeight(height)
     , mTextureFactor(1.0f)
 {
+    mOwner->RegisterComponent(this);
+
     mTexture = owner->GetGame()->GetRenderer()->GetTexture(texPath);
     assert(mTexture != nullptr);
 }
@@ -27,7 +29,7 @@ void TextureComponent::Draw(Renderer* renderer)
     if (!mIsVisible)
         return;
 
-    Vector2 position = mOwner->GetPosition();
+    Vector2 position = mOwner->GetRenderPosition();
     float rotation = mOwner->GetRotation();
     Vector2 size(static_cast<float>(mWidth), static_cast<float>(mHeight));
     size.x *= GetOwner()->GetScale().x;
@@ -35,5 +37,15 @@ void TextureComponent::Draw(Renderer* renderer)
     Vector3 color(1.0f, 1.0f, 1.0f);
     Vector4 texRect(0.0f, 0.0f, 1.0f, 1.0f);
 
-    renderer->DrawTexture(position, size, rotation, color, mTexture, texRect, mOwner->GetGame()->GetCameraPos());
-}
\ No newline at end of file
+    renderer->DrawTexture(position, size, rotation, color, mTexture, texRect, mOwner->GetGame()->GetRenderCameraPos());
+}
+
+bool TextureComponent::GetWorldBounds(Vector2& outMin, Vector2& outMax) const
+{
+    Vector2 size(static_cast<float>(mWidth), static_cast<float>(mHeight));
+    size.x *= GetOwner()->GetScale().x;
+    size.y *= GetOwner()->GetScale().y;
+
+    GetCenteredBounds(mOwner->GetRenderPosition(), size, mOwner->GetRotation(), outMin, outMax);
+    return true;
+}
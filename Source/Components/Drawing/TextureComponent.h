@@ -15,6 +15,7 @@ public:
                      int width, int height, int drawOrder = 100);
 
     void Draw(class Renderer* renderer) override;
+    bool GetWorldBounds(Vector2& outMin, Vector2& outMax) const override;
 
     void SetTextureFactor(float factor) { mTextureFactor = factor; }
     float GetTextureFactor() const { return mTextureFactor; }
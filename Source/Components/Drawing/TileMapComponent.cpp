@@ -0,0 +1,172 @@
+//
+// TileMapComponent.cpp
+//
+
+#include "TileMapComponent.h"
+#include <algorithm>
+#include "../../Game.h"
+#include "../../Actors/TileMap.h"
+#include "../../Renderer/Renderer.h"
+#include "../../Renderer/VertexArray.h"
+#include "../../Utils/Profiler.h"
+
+TileMapComponent::TileMapComponent(TileMap* owner, const int drawOrder)
+    : DrawComponent(owner, drawOrder)
+    , mTileMap(owner)
+    , mChunksX((owner->GetWidth() + CHUNK_SIZE - 1) / CHUNK_SIZE)
+    , mChunksY((owner->GetHeight() + CHUNK_SIZE - 1) / CHUNK_SIZE)
+    , mChunks(static_cast<size_t>(mChunksX) * mChunksY)
+{
+    mOwner->RegisterComponent(this);
+}
+
+TileMapComponent::~TileMapComponent()
+{
+    for (auto& chunk : mChunks)
+    {
+        ClearChunk(chunk);
+    }
+}
+
+void TileMapComponent::MarkTileDirty(const int col, const int row)
+{
+    if (col < 0 || row < 0 || col >= mTileMap->GetWidth() || row >= mTileMap->GetHeight())
+        return;
+
+    mChunks[(row / CHUNK_SIZE) * mChunksX + col / CHUNK_SIZE].dirty = true;
+}
+
+void TileMapComponent::ClearChunk(Chunk& chunk)
+{
+    for (auto& mesh : chunk.meshes)
+    {
+        delete mesh.vertices;
+    }
+    chunk.meshes.clear();
+}
+
+void TileMapComponent::BuildChunk(Renderer* renderer, const int chunkX, const int chunkY)
+{
+    PROFILE_SCOPE("TileMapComponent::BuildChunk");
+
+    Chunk& chunk = mChunks[chunkY * mChunksX + chunkX];
+    ClearChunk(chunk);
+    chunk.dirty = false;
+
+    // Same corners/UVs as the sprite quad (top-right, top-left, bottom-right, bottom-left)
+    static const float corners[4][4] = {
+        { 0.5f,  0.5f, 1.0f, 1.0f},
+        {-0.5f,  0.5f, 0.0f, 1.0f},
+        { 0.5f, -0.5f, 1.0f, 0.0f},
+        {-0.5f, -0.5f, 0.0f, 0.0f}
+    };
+
+    const int firstCol = chunkX * CHUNK_SIZE;
+    const int firstRow = chunkY * CHUNK_SIZE;
+    const int lastCol = std::min(firstCol + CHUNK_SIZE, mTileMap->GetWidth());
+    const int lastRow = std::min(firstRow + CHUNK_SIZE, mTileMap->GetHeight());
+    const float tileSize = static_cast<float>(Game::TILE_SIZE);
+
+    // One mesh per atlas page used in the chunk, vertices relative to its first tile
+    std::vector<const Texture*> textures;
+    std::vector<std::vector<float>> vertices;
+    for (int row = firstRow; row < lastRow; ++row)
+    {
+        for (int col = firstCol; col < lastCol; ++col)
+        {
+            Texture* texture = mTileMap->GetTileTexture(mTileMap->GetTile(col, row));
+            if (!texture)
+                continue;
+
+            // Still loading: leave the tile out and bake the chunk again later
+            if (texture->IsPending())
+            {
+                chunk.dirty = true;
+                continue;
+            }
+
+            const Texture* page = texture->GetPage();
+            const auto iter = std::find(textures.begin(), textures.end(), page);
+            const size_t meshIndex = iter - textures.begin();
+            if (iter == textures.end())
+            {
+                textures.emplace_back(page);
+                vertices.emplace_back();
+            }
+
+            const Vector4& uvRect = texture->GetAtlasRect();
+
+            // Tiles are centered on their cell origin, like the sprites they replace
+            const float centerX = static_cast<float>(col - firstCol) * tileSize;
+            const float centerY = static_cast<float>(row - firstRow) * tileSize;
+            for (const auto& corner : corners)
+            {
+                vertices[meshIndex].insert(vertices[meshIndex].end(), {
+                    centerX + corner[0] * tileSize, centerY + corner[1] * tileSize, 0.0f,
+                    uvRect.x + corner[2] * uvRect.z, uvRect.y + corner[3] * uvRect.w
+                });
+            }
+        }
+    }
+
+    std::vector<unsigned int> indices;
+    for (size_t i = 0; i < textures.size(); ++i)
+    {
+        const unsigned int numVerts = static_cast<unsigned int>(vertices[i].size() / 5);
+
+        indices.clear();
+        for (unsigned int quad = 0; quad < numVerts; quad += 4)
+        {
+            indices.insert(indices.end(), {quad, quad + 1, quad + 2, quad + 1, quad + 3, quad + 2});
+        }
+
+        VertexArray* vertexArray = renderer->CreateVertexArray(vertices[i].data(), numVerts, indices.data(),
+                                                               static_cast<unsigned int>(indices.size()));
+        chunk.meshes.emplace_back(ChunkMesh{textures[i], vertexArray});
+    }
+}
+
+void TileMapComponent::Draw(Renderer* renderer)
+{
+    PROFILE_SCOPE("TileMapComponent::Draw");
+
+    if (!mIsVisible)
+        return;
+
+    // Sprites are centered on the tile origin, so pad the view by a tile on each side
+    const Vector2 cameraPos = GetGame()->GetRenderCameraPos();
+    const Vector2 padding(Game::TILE_SIZE, Game::TILE_SIZE);
+    const Vector2 viewMin = cameraPos - padding;
+    const Vector2 viewMax = cameraPos + Vector2(Game::WINDOW_WIDTH, Game::WINDOW_HEIGHT) + padding;
+
+    int minCol, minRow, maxCol, maxRow;
+    if (!mTileMap->GetCellRange(viewMin, viewMax, minCol, minRow, maxCol, maxRow))
+        return;
+
+    for (int chunkY = minRow / CHUNK_SIZE; chunkY <= maxRow / CHUNK_SIZE; ++chunkY)
+    {
+        for (int chunkX = minCol / CHUNK_SIZE; chunkX <= maxCol / CHUNK_SIZE; ++chunkX)
+        {
+            if (mChunks[chunkY * mChunksX + chunkX].dirty)
+            {
+                BuildChunk(renderer, chunkX, chunkY);
+            }
+
+            const Vector2 origin = mTileMap->GetTilePosition(chunkX * CHUNK_SIZE, chunkY * CHUNK_SIZE);
+            for (const auto& mesh : mChunks[chunkY * mChunksX + chunkX].meshes)
+            {
+                renderer->DrawMesh(origin, mColor, mesh.texture, mesh.vertices, cameraPos);
+            }
+        }
+    }
+}
+
+void TileMapComponent::DebugDraw(Renderer* renderer)
+{
+    const Vector2 cameraPos = GetGame()->GetRenderCameraPos();
+    const Vector2 viewMax = cameraPos + Vector2(Game::WINDOW_WIDTH, Game::WINDOW_HEIGHT);
+
+    mTileMap->ForEachSolidTile(cameraPos, viewMax, [&](const Vector2& tileMin, const Vector2& tileMax) {
+        renderer->DrawRect(tileMin, tileMax - tileMin, 0.0f, Color::Green, cameraPos, RendererMode::LINES);
+    });
+}
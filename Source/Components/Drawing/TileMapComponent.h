@@ -0,0 +1,48 @@
+//
+// TileMapComponent.h
+//
+
+#pragma once
+
+#include <vector>
+#include "DrawComponent.h"
+
+// Draws the tiles of its TileMap owner. Tiles are baked into one static mesh per
+// texture for each CHUNK_SIZE x CHUNK_SIZE block of cells, so the visible terrain
+// costs a few draw calls; a chunk is only rebuilt after one of its tiles changes.
+class TileMapComponent : public DrawComponent
+{
+public:
+    static const int CHUNK_SIZE = 16;
+
+    explicit TileMapComponent(class TileMap* owner, int drawOrder = 100);
+    ~TileMapComponent() override;
+
+    void Draw(class Renderer* renderer) override;
+    void DebugDraw(class Renderer* renderer) override;
+
+    // Flags the chunk holding this cell to be rebuilt before it's drawn again
+    void MarkTileDirty(int col, int row);
+
+private:
+    struct ChunkMesh
+    {
+        const class Texture* texture;
+        class VertexArray* vertices;
+    };
+
+    struct Chunk
+    {
+        std::vector<ChunkMesh> meshes;
+        bool dirty = true;
+    };
+
+    void BuildChunk(class Renderer* renderer, int chunkX, int chunkY);
+    void ClearChunk(Chunk& chunk);
+
+    class TileMap* mTileMap;
+
+    int mChunksX;
+    int mChunksY;
+    std::vector<Chunk> mChunks;
+};
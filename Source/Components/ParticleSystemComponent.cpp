@@ -7,6 +7,7 @@
 #include "Physics/AABBColliderComponent.h"
 #include "Physics/RigidBodyComponent.h"
 #include "Drawing/RectComponent.h"
+#include "ComponentPool.h"
 
 Particle::Particle(class Game* game, const std::string& uniqueName, int width, int height)
     : Actor(game, uniqueName)
@@ -61,6 +62,9 @@ void Particle::OnUpdate(float deltaTime)
 ParticleSystemComponent::ParticleSystemComponent(class Actor* owner, int particleW, int particleH, int poolSize, int updateOrder)
     : Component(owner, updateOrder)
 {
+    mOwner->RegisterComponent(this);
+    mUpdatesWithOwner = false;
+
     // Create a pool of particles
     for (int i = 0; i < poolSize; i++)
     {
@@ -81,10 +85,20 @@ void ParticleSystemComponent::EmitParticle(float lifetime, float speed, const Ve
 
             // Forward velocity
             Vector2 direction = mOwner->GetScale();
-            p->GetComponent<RigidBodyComponent>()->ApplyForce(direction * speed);
+            p->GetRigidBody()->ApplyForce(direction * speed);
 
             // Break inner loop to emit only one particle per iteration
             break;
         }
     }
-}
\ No newline at end of file
+}
+
+void* ParticleSystemComponent::operator new(size_t size)
+{
+    return ComponentPool<ParticleSystemComponent>::Get().Allocate(size);
+}
+
+void ParticleSystemComponent::operator delete(void* p, size_t size)
+{
+    ComponentPool<ParticleSystemComponent>::Get().Free(p, size);
+}
@@ -19,6 +19,8 @@ public:
     void Awake(const Vector2 &position, float rotation, float lifetime = 1.0f);
     void Kill() override;
 
+    class RigidBodyComponent* GetRigidBody() const { return mRigidBodyComponent; }
+
 private:
     float mLifeTime;
     bool mIsDead;
@@ -34,6 +36,10 @@ public:
     ParticleSystemComponent(class Actor* owner, int partibleW, int particleH,  int poolSize = 100, int updateOrder = 10);
     void EmitParticle(float lifetime, float speed, const Vector2& offsetPosition = Vector2::Zero);
 
+    // Instances are allocated from ComponentPool<ParticleSystemComponent>
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size);
+
 private:
     std::vector<class Particle*> mParticles;
 };
@@ -6,6 +6,11 @@
 #include "../../Actors/Actor.h"
 #include "../../Game.h"
 #include "../../Actors/Cat.h"
+#include "RigidBodyComponent.h"
+#include "../../Actors/TileMap.h"
+#include "../../Utils/Profiler.h"
+#include "../ComponentPool.h"
+#include <algorithm>
 
 AABBColliderComponent::AABBColliderComponent(class Actor* owner, int dx, int dy, int w, int h,
                                              ColliderLayer layer, bool isStatic, int updateOrder)
@@ -15,15 +20,34 @@ AABBColliderComponent::AABBColliderComponent(class Actor* owner, int dx, int dy,
         ,mWidth(w)
         ,mHeight(h)
         ,mLayer(layer)
+        ,mGridCells{}
+        ,mIsInGrid(false)
+        ,mGridQueryStamp(0)
 {
-    GetGame()->AddCollider(this);
     mOrigWidth = w;
     mOrigHeight = h;
     mOrigOffset = mOffset;
+    GetGame()->AddCollider(this);
+    mOwner->AddCollider(this);
+    mOwner->RegisterComponent(this);
+    mUpdatesWithOwner = false;
+
+    // Rigid bodies are created before their collider; hand it over so they don't look it up every tick
+    if (auto rigidBody = mOwner->GetComponent<RigidBodyComponent>())
+    {
+        rigidBody->SetCollider(this);
+    }
 }
 
 AABBColliderComponent::~AABBColliderComponent()
 {
+    auto rigidBody = mOwner->GetComponent<RigidBodyComponent>();
+    if (rigidBody && rigidBody->GetCollider() == this)
+    {
+        rigidBody->SetCollider(nullptr);
+    }
+
+    mOwner->RemoveCollider(this);
     GetGame()->RemoveCollider(this);
 }
 
@@ -64,10 +88,22 @@ bool AABBColliderComponent::Intersect(const AABBColliderComponent& b)
     return true;
 }
 
+bool AABBColliderComponent::Intersect(const Vector2& otherMin, const Vector2& otherMax) const
+{
+    const Vector2 min = GetMin();
+    const Vector2 max = GetMax();
+    return !(max.x <= otherMin.x || otherMax.x <= min.x || max.y <= otherMin.y || otherMax.y <= min.y);
+}
+
 float AABBColliderComponent::GetMinHorizontalOverlap(AABBColliderComponent* b)
 {
-    const float overlapLeft = GetMax().x - b->GetMin().x;
-    const float overlapRight = b->GetMax().x - GetMin().x;
+    return GetMinHorizontalOverlap(b->GetMin(), b->GetMax());
+}
+
+float AABBColliderComponent::GetMinHorizontalOverlap(const Vector2& otherMin, const Vector2& otherMax) const
+{
+    const float overlapLeft = GetMax().x - otherMin.x;
+    const float overlapRight = otherMax.x - GetMin().x;
 
     if (std::abs(overlapLeft) < std::abs(overlapRight))
         return -overlapLeft;
@@ -77,8 +113,13 @@ float AABBColliderComponent::GetMinHorizontalOverlap(AABBColliderComponent* b)
 
 float AABBColliderComponent::GetMinVerticalOverlap(AABBColliderComponent* b)
 {
-    const float overlapTop = GetMax().y - b->GetMin().y;
-    const float overlapBottom = b->GetMax().y - GetMin().y;
+    return GetMinVerticalOverlap(b->GetMin(), b->GetMax());
+}
+
+float AABBColliderComponent::GetMinVerticalOverlap(const Vector2& otherMin, const Vector2& otherMax) const
+{
+    const float overlapTop = GetMax().y - otherMin.y;
+    const float overlapBottom = otherMax.y - GetMin().y;
 
     if (std::abs(overlapTop) < std::abs(overlapBottom))
         return -overlapTop;
@@ -86,13 +127,33 @@ float AABBColliderComponent::GetMinVerticalOverlap(AABBColliderComponent* b)
         return overlapBottom;
 }
 
+Vector2 AABBColliderComponent::GetQueryMargin() const
+{
+    // A resolve pushes us by at most half our size plus half the other box's.
+    // Widening by our size plus the largest box (collider or tile) covers that
+    // push with slack for the next, so boxes we are pushed into are still tested.
+    Vector2 largest = GetGame()->GetCollisionGrid().GetMaxColliderSize();
+    if (const TileMap* tileMap = GetGame()->GetTileMap())
+    {
+        const float tileSize = static_cast<float>(tileMap->GetTileSize());
+        largest = Vector2(std::max(largest.x, tileSize), std::max(largest.y, tileSize));
+    }
+
+    return Vector2(static_cast<float>(mWidth) + largest.x, static_cast<float>(mHeight) + largest.y);
+}
+
 float AABBColliderComponent::DetectHorizontalCollision(RigidBodyComponent *rigidBody)
 {
+    PROFILE_SCOPE("AABBColliderComponent::DetectHorizontalCollision");
+
     if (mIsStatic || !mIsEnabled) return 0.0f;
 
     float totalDisplacement = 0.0f;
 
-    auto colliders = GetGame()->GetColliders();
+    const Vector2 margin(GetQueryMargin().x, 0.0f);
+    std::vector<AABBColliderComponent*> colliders;
+    colliders.reserve(QUERY_RESERVE);
+    GetGame()->GetCollisionGrid().Query(GetMin() - margin, GetMax() + margin, colliders);
 
     for (auto* other : colliders)
     {
@@ -113,16 +174,39 @@ float AABBColliderComponent::DetectHorizontalCollision(RigidBodyComponent *rigid
         }
     }
 
+    // Static level tiles are tested straight from the tile map's grid
+    if (TileMap* tileMap = GetGame()->GetTileMap())
+    {
+        tileMap->ForEachSolidTile(GetMin() - margin, GetMax() + margin, [&](const Vector2& tileMin, const Vector2& tileMax) {
+            if (!Intersect(tileMin, tileMax))
+                return;
+
+            const float overlapX = GetMinHorizontalOverlap(tileMin, tileMax);
+            if (overlapX != 0.0f)
+            {
+                GetOwner()->OnHorizontalCollision(overlapX, tileMap->GetTileCollider());
+
+                ResolveHorizontalCollisions(rigidBody, overlapX);
+                totalDisplacement += overlapX;
+            }
+        });
+    }
+
     return totalDisplacement;
 }
 
 float AABBColliderComponent::DetectVerticalCollision(RigidBodyComponent *rigidBody)
 {
+    PROFILE_SCOPE("AABBColliderComponent::DetectVerticalCollision");
+
     if (mIsStatic || !mIsEnabled) return 0.0f;
 
     float totalDisplacement = 0.0f;
 
-    auto colliders = GetGame()->GetColliders();
+    const Vector2 margin(0.0f, GetQueryMargin().y);
+    std::vector<AABBColliderComponent*> colliders;
+    colliders.reserve(QUERY_RESERVE);
+    GetGame()->GetCollisionGrid().Query(GetMin() - margin, GetMax() + margin, colliders);
 
     for (auto* other : colliders)
     {
@@ -143,6 +227,23 @@ float AABBColliderComponent::DetectVerticalCollision(RigidBodyComponent *rigidBo
         }
     }
 
+    if (TileMap* tileMap = GetGame()->GetTileMap())
+    {
+        tileMap->ForEachSolidTile(GetMin() - margin, GetMax() + margin, [&](const Vector2& tileMin, const Vector2& tileMax) {
+            if (!Intersect(tileMin, tileMax))
+                return;
+
+            const float overlapY = GetMinVerticalOverlap(tileMin, tileMax);
+            if (overlapY != 0.0f)
+            {
+                ResolveVerticalCollisions(rigidBody, overlapY);
+                totalDisplacement += overlapY;
+
+                GetOwner()->OnVerticalCollision(overlapY, tileMap->GetTileCollider());
+            }
+        });
+    }
+
     return totalDisplacement;
 }
 
@@ -176,8 +277,9 @@ void AABBColliderComponent::ResolveVerticalCollisions(RigidBodyComponent *rigidB
 
 void AABBColliderComponent::DebugDraw(class Renderer *renderer)
 {
-    renderer->DrawRect(GetMin(),Vector2(mWidth, mHeight), mOwner->GetRotation(),
-                       Color::Green, mOwner->GetGame()->GetCameraPos(), RendererMode::LINES);
+    const Vector2 renderMin = GetMin() - mOwner->GetPosition() + mOwner->GetRenderPosition();
+    renderer->DrawRect(renderMin,Vector2(mWidth, mHeight), mOwner->GetRotation(),
+                       Color::Green, mOwner->GetGame()->GetRenderCameraPos(), RendererMode::LINES);
 }
 
 void AABBColliderComponent::Resize(const int w, const int h, const Vector2 offset)
@@ -185,4 +287,16 @@ void AABBColliderComponent::Resize(const int w, const int h, const Vector2 offse
     mWidth = w;
     mHeight = h;
     mOffset = offset;
+
+    GetGame()->UpdateCollider(this);
+}
+
+void* AABBColliderComponent::operator new(size_t size)
+{
+    return ComponentPool<AABBColliderComponent>::Get().Allocate(size);
+}
+
+void AABBColliderComponent::operator delete(void* p, size_t size)
+{
+    ComponentPool<AABBColliderComponent>::Get().Free(p, size);
 }
@@ -6,6 +6,7 @@
 #include "../Component.h"
 #include "../../Math.h"
 #include "RigidBodyComponent.h"
+#include "CollisionGrid.h"
 #include <vector>
 #include <set>
 
@@ -24,6 +25,10 @@ public:
                                 ColliderLayer layer, bool isStatic = false, int updateOrder = 10);
     ~AABBColliderComponent() override;
 
+    // Instances are allocated from ComponentPool<AABBColliderComponent>
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size);
+
     bool Intersect(const AABBColliderComponent& b);
     bool IntersectX(const AABBColliderComponent& b);
     bool IntersectY(const AABBColliderComponent& b);
@@ -49,9 +54,21 @@ public:
 
 
 private:
+    friend class CollisionGrid;
+
     float GetMinVerticalOverlap(AABBColliderComponent* b);
     float GetMinHorizontalOverlap(AABBColliderComponent* b);
 
+    // Box versions, used for tile map cells
+    bool Intersect(const Vector2& otherMin, const Vector2& otherMax) const;
+    float GetMinVerticalOverlap(const Vector2& otherMin, const Vector2& otherMax) const;
+    float GetMinHorizontalOverlap(const Vector2& otherMin, const Vector2& otherMax) const;
+
+    // How far past our box the broadphase looks before resolving collisions
+    Vector2 GetQueryMargin() const;
+    // Colliders a query usually returns, so the result vector rarely reallocates
+    static const int QUERY_RESERVE = 16;
+
     void ResolveHorizontalCollisions(RigidBodyComponent *rigidBody, const float minOverlap) const;
     void ResolveVerticalCollisions(RigidBodyComponent *rigidBody, const float minOverlap) const;
 
@@ -59,4 +76,13 @@ private:
     bool mIsStatic;
 
     ColliderLayer mLayer;
+
+    // Broadphase bookkeeping (owned by CollisionGrid)
+    CollisionGrid::CellRange mGridCells;
+    bool mIsInGrid;
+    uint32_t mGridQueryStamp;
+
+    // Slot in Game's collider list (owned by Game)
+    friend class Game;
+    int mColliderIndex = -1;
 };
\ No newline at end of file
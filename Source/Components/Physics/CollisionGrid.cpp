@@ -0,0 +1,135 @@
+//
+// CollisionGrid.cpp
+//
+
+#include "CollisionGrid.h"
+#include <algorithm>
+#include <cmath>
+#include "AABBColliderComponent.h"
+
+CollisionGrid::CollisionGrid(const int cellSize)
+    : mCellSize(cellSize)
+    , mInvCellSize(1.0f / static_cast<float>(cellSize))
+    , mQueryStamp(0)
+    , mMaxColliderSize(Vector2::Zero)
+{
+}
+
+CollisionGrid::CellRange CollisionGrid::ComputeRange(const Vector2& min, const Vector2& max) const
+{
+    CellRange range{};
+    range.minX = static_cast<int>(std::floor(min.x * mInvCellSize));
+    range.minY = static_cast<int>(std::floor(min.y * mInvCellSize));
+
+    // Max edge is exclusive, so a tile-aligned box only covers its own cell
+    range.maxX = std::max(range.minX, static_cast<int>(std::ceil(max.x * mInvCellSize)) - 1);
+    range.maxY = std::max(range.minY, static_cast<int>(std::ceil(max.y * mInvCellSize)) - 1);
+    return range;
+}
+
+void CollisionGrid::AddToCells(AABBColliderComponent* collider, const CellRange& range)
+{
+    for (int x = range.minX; x <= range.maxX; x++)
+    {
+        for (int y = range.minY; y <= range.maxY; y++)
+        {
+            mCells[CellKey(x, y)].emplace_back(collider);
+        }
+    }
+}
+
+void CollisionGrid::RemoveFromCells(AABBColliderComponent* collider, const CellRange& range)
+{
+    for (int x = range.minX; x <= range.maxX; x++)
+    {
+        for (int y = range.minY; y <= range.maxY; y++)
+        {
+            auto cell = mCells.find(CellKey(x, y));
+            if (cell == mCells.end())
+                continue;
+
+            auto& colliders = cell->second;
+            auto iter = std::find(colliders.begin(), colliders.end(), collider);
+            if (iter != colliders.end())
+            {
+                // Swap to end of vector and pop off (avoid erase copies)
+                std::iter_swap(iter, colliders.end() - 1);
+                colliders.pop_back();
+            }
+        }
+    }
+}
+
+void CollisionGrid::GrowMaxColliderSize(const AABBColliderComponent* collider)
+{
+    mMaxColliderSize.x = std::max(mMaxColliderSize.x, static_cast<float>(collider->mWidth));
+    mMaxColliderSize.y = std::max(mMaxColliderSize.y, static_cast<float>(collider->mHeight));
+}
+
+void CollisionGrid::Insert(AABBColliderComponent* collider)
+{
+    if (collider->mIsInGrid)
+        return;
+
+    GrowMaxColliderSize(collider);
+
+    collider->mGridCells = ComputeRange(collider->GetMin(), collider->GetMax());
+    collider->mIsInGrid = true;
+    AddToCells(collider, collider->mGridCells);
+}
+
+void CollisionGrid::Clear()
+{
+    mCells.clear();
+    mMaxColliderSize = Vector2::Zero;
+}
+
+void CollisionGrid::Remove(AABBColliderComponent* collider)
+{
+    if (!collider->mIsInGrid)
+        return;
+
+    RemoveFromCells(collider, collider->mGridCells);
+    collider->mIsInGrid = false;
+}
+
+void CollisionGrid::Update(AABBColliderComponent* collider)
+{
+    if (!collider->mIsInGrid)
+        return;
+
+    GrowMaxColliderSize(collider);
+
+    const CellRange range = ComputeRange(collider->GetMin(), collider->GetMax());
+    if (range == collider->mGridCells)
+        return;
+
+    RemoveFromCells(collider, collider->mGridCells);
+    collider->mGridCells = range;
+    AddToCells(collider, range);
+}
+
+void CollisionGrid::Query(const Vector2& min, const Vector2& max, std::vector<AABBColliderComponent*>& outColliders)
+{
+    const CellRange range = ComputeRange(min, max);
+
+    mQueryStamp++;
+    for (int x = range.minX; x <= range.maxX; x++)
+    {
+        for (int y = range.minY; y <= range.maxY; y++)
+        {
+            auto cell = mCells.find(CellKey(x, y));
+            if (cell == mCells.end())
+                continue;
+
+            for (auto* collider : cell->second)
+            {
+                if (collider->mGridQueryStamp == mQueryStamp)
+                    continue;
+
+                collider->mGridQueryStamp = mQueryStamp;
+                outColliders.emplace_back(collider);
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+//
+// CollisionGrid.h
+//
+
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "../../Math.h"
+
+// Uniform grid (spatial hash) used as the broadphase for AABB collisions.
+// Each collider is stored in every cell its box overlaps; the cells it
+// occupies are cached on the collider so moving it only touches the grid
+// when it actually crosses a cell boundary.
+class CollisionGrid
+{
+public:
+    // Inclusive range of cells covered by a collider
+    struct CellRange
+    {
+        int minX, minY, maxX, maxY;
+
+        bool operator==(const CellRange& other) const
+        {
+            return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+        }
+    };
+
+    explicit CollisionGrid(int cellSize);
+
+    void Insert(class AABBColliderComponent* collider);
+    void Remove(class AABBColliderComponent* collider);
+
+    // Re-registers the collider if its box now overlaps a different set of cells
+    void Update(class AABBColliderComponent* collider);
+
+    // Forgets every collider without touching them (for tearing down a scene)
+    void Clear();
+
+    // Appends to outColliders every collider registered in a cell overlapped
+    // by [min, max). Each collider is reported at most once per query.
+    void Query(const Vector2& min, const Vector2& max, std::vector<class AABBColliderComponent*>& outColliders);
+
+    int GetCellSize() const { return mCellSize; }
+
+    // Width and height of the largest collider registered since the last Clear
+    const Vector2& GetMaxColliderSize() const { return mMaxColliderSize; }
+
+private:
+    CellRange ComputeRange(const Vector2& min, const Vector2& max) const;
+    void AddToCells(class AABBColliderComponent* collider, const CellRange& range);
+    void RemoveFromCells(class AABBColliderComponent* collider, const CellRange& range);
+    void GrowMaxColliderSize(const class AABBColliderComponent* collider);
+
+    static int64_t CellKey(int x, int y)
+    {
+        return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y);
+    }
+
+    int mCellSize;
+    float mInvCellSize;
+
+    // Stamp used to report each collider once per query
+    uint32_t mQueryStamp;
+
+    // Only grows (colliders can be scaled from the terminal) until the scene is cleared
+    Vector2 mMaxColliderSize;
+
+    std::unordered_map<int64_t, std::vector<class AABBColliderComponent*>> mCells;
+};
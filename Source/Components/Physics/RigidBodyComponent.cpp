@@ -7,6 +7,8 @@
 #include "../../Game.h"
 #include "RigidBodyComponent.h"
 #include "AABBColliderComponent.h"
+#include "../../Utils/Profiler.h"
+#include "../ComponentPool.h"
 
 const float MAX_SPEED_X = 750.0f;
 const float MAX_SPEED_Y = 750.0f;
@@ -19,8 +21,10 @@ RigidBodyComponent::RigidBodyComponent(class Actor* owner, float mass, float fri
         ,mFrictionCoefficient(friction)
         ,mVelocity(Vector2::Zero)
         ,mAcceleration(Vector2::Zero)
+        ,mCollider(mOwner->GetComponent<AABBColliderComponent>())
 {
-
+    mOwner->RegisterComponent(this);
+    mUpdatesWithOwner = false;
 }
 
 void RigidBodyComponent::ApplyForce(const Vector2 &force)
@@ -30,6 +34,8 @@ void RigidBodyComponent::ApplyForce(const Vector2 &force)
 
 void RigidBodyComponent::Update(float deltaTime)
 {
+    PROFILE_SCOPE("RigidBodyComponent::Update");
+
     // Apply gravity acceleration
     if(mApplyGravity)
     {
@@ -53,7 +59,7 @@ void RigidBodyComponent::Update(float deltaTime)
         mVelocity.x = 0.f;
     }
 
-    auto collider = mOwner->GetComponent<AABBColliderComponent>();
+    auto collider = mCollider;
 
     mOwner->SetPosition(Vector2(mOwner->GetPosition().x + mVelocity.x * deltaTime,
                                      mOwner->GetPosition().y));
@@ -72,4 +78,14 @@ void RigidBodyComponent::Update(float deltaTime)
     }
 
     mAcceleration.Set(0.f, 0.f);
-}
\ No newline at end of file
+}
+
+void* RigidBodyComponent::operator new(size_t size)
+{
+    return ComponentPool<RigidBodyComponent>::Get().Allocate(size);
+}
+
+void RigidBodyComponent::operator delete(void* p, size_t size)
+{
+    ComponentPool<RigidBodyComponent>::Get().Free(p, size);
+}
@@ -15,6 +15,10 @@ public:
 
     void Update(float deltaTime) override;
 
+    // Instances are allocated from ComponentPool<RigidBodyComponent>
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size);
+
     const Vector2& GetVelocity() const { return mVelocity; }
     void SetVelocity(const Vector2& velocity) { mVelocity = velocity; }
 
@@ -25,6 +29,10 @@ public:
 
     void ApplyForce(const Vector2 &force);
 
+    // Collider moved by this body (set by the collider when it is created)
+    class AABBColliderComponent* GetCollider() const { return mCollider; }
+    void SetCollider(class AABBColliderComponent* collider) { mCollider = collider; }
+
 private:
     bool mApplyGravity;
 
@@ -34,4 +42,6 @@ private:
 
     Vector2 mVelocity;
     Vector2 mAcceleration;
+
+    class AABBColliderComponent* mCollider;
 };
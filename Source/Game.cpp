@@ -10,14 +10,17 @@
 #include <vector>
 #include <map>
 #include <fstream>
-#include "CSV.h"
+#include <chrono>
 #include "Game.h"
 
 #include <sstream>
 #include <SDL_ttf.h>
 
 #include "Components/Drawing/DrawComponent.h"
+#include "Components/Drawing/AnimatorComponent.h"
+#include "Components/ComponentPool.h"
 #include "Components/Physics/RigidBodyComponent.h"
+#include "Components/Physics/AABBColliderComponent.h"
 #include "Random.h"
 #include "Terminal.h"
 #include "Actors/Actor.h"
@@ -25,70 +28,152 @@
 #include "Actors/Block.h"
 #include "Actors/MovingBlock.h"
 #include "Actors/Spawner.h"
+#include "Actors/TileMap.h"
 #include "Actors/Cat.h"
 #include "Actors/SpawnBlock.h"
 #include "Utils/DialogManager.h"
 #include "Utils/ObjectManager.h"
+#include "Utils/LevelCache.h"
 #include "Renderer/Font.h"
+#include "Renderer/FontRegistry.h"
+#include "Renderer/NullRenderer.h"
 #include "AudioSystem.h"
+#include "Utils/Log.h"
+#include "Utils/SceneArena.h"
 #include "MainMenu.h"
 #include "Actors/Dog.h"
 #include "Utils/TerminalHelper.h"
+#include "Utils/Profiler.h"
 
-Game::Game()
-    : mWindow(nullptr), mRenderer(nullptr), mTicksCount(0), mIsRunning(true), mIsDebugging(false), mUpdatingActors(false), mCameraPos(0.f, 0.f), mCat(nullptr), mLevelData(nullptr), mTerminal(nullptr), mCurrentScene(GameScene::MainMenu), mUiFont(nullptr), mAudio(nullptr)
+Game::Game(bool isHeadless)
+    : mWindow(nullptr), mRenderer(nullptr), mLastFrameCounter(0), mTickDeltaTime(1.0f / FPS), mAccumulator(0.f), mRenderAlpha(0.f), mIsHeadless(isHeadless), mTickLimit(0), mIsRunning(true), mIsDebugging(false), mUpdatingActors(false), mCameraPos(0.f, 0.f), mPrevCameraPos(0.f, 0.f), mCollisionGrid(TILE_SIZE), mCat(nullptr), mTerminal(nullptr), mCurrentScene(GameScene::MainMenu), mAudio(nullptr)
 {
 }
 
 bool Game::Initialize()
 {
     Random::Init();
+    RegisterTerminalCommands();
+
+    if (mIsHeadless)
+    {
+        // No window, GL context, mixer device or fonts: only the timer is needed
+        if (SDL_Init(SDL_INIT_TIMER) != 0)
+        {
+            LOG_ERROR(Core, "Unable to initialize SDL: %s", SDL_GetError());
+            return false;
+        }
+
+        mRenderer = new NullRenderer(this);
+        mRenderer->Initialize(WINDOW_WIDTH, WINDOW_HEIGHT);
+
+        mAudio = new NullAudioSystem();
+        mAudio->Initialize();
+
+        mMainMenu = new MainMenu(this, nullptr);
+
+        return true;
+    }
 
     if (SDL_Init(SDL_INIT_VIDEO) != 0)
     {
-        SDL_Log("Unable to initialize SDL: %s", SDL_GetError());
+        LOG_ERROR(Core, "Unable to initialize SDL: %s", SDL_GetError());
         return false;
     }
 
     if (TTF_Init() == -1)
     {
-        SDL_Log("Failed to initialize SDL_ttf: %s", TTF_GetError());
+        LOG_ERROR(Core, "Failed to initialize SDL_ttf: %s", TTF_GetError());
         return false;
     }
 
     mWindow = SDL_CreateWindow("miaoware", 100, 100, WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_OPENGL);
     if (!mWindow)
     {
-        SDL_Log("Failed to create window: %s", SDL_GetError());
+        LOG_ERROR(Core, "Failed to create window: %s", SDL_GetError());
         return false;
     }
 
     int imgFlags = IMG_INIT_PNG | IMG_INIT_JPG;
     if ((IMG_Init(imgFlags) & imgFlags) != imgFlags)
     {
-        SDL_Log("Unable to initialize SDL_image: %s", IMG_GetError());
+        LOG_ERROR(Core, "Unable to initialize SDL_image: %s", IMG_GetError());
         return false;
     }
 
     mRenderer = new Renderer(mWindow, this);
     mRenderer->Initialize(WINDOW_WIDTH, WINDOW_HEIGHT);
 
-    mUiFont = new Font();
-    mUiFont->Load("../Assets/Fonts/Arial.ttf");
+    mUiFont = FontRegistry::Acquire("../Assets/Fonts/Arial.ttf");
 
     mAudio = new AudioSystem();
     if (!mAudio->Initialize())
     {
-        SDL_Log("AudioSystem failed to initialize");
+        LOG_WARN(Audio, "AudioSystem failed to initialize");
     }
 
-    mMainMenu = new MainMenu(this, mUiFont);
+    mMainMenu = new MainMenu(this, mUiFont.get());
 
-    mTicksCount = SDL_GetTicks();
+    mLastFrameCounter = SDL_GetPerformanceCounter();
 
     return true;
 }
 
+void Game::ReleaseScene()
+{
+    PROFILE_SCOPE("Game::ReleaseScene");
+
+    const Uint64 releaseStart = SDL_GetPerformanceCounter();
+
+    std::vector<Actor *> actors;
+    actors.swap(mActors);
+    actors.insert(actors.end(), mPendingActors.begin(), mPendingActors.end());
+    mPendingActors.clear();
+
+    // Empty the registries wholesale; the destructors below see mIsReleasingScene and skip them
+    mIsReleasingScene = true;
+
+    for (uint32_t slot = 0; slot < mActorSlots.size(); slot++)
+    {
+        if (mActorSlots[slot].actor)
+        {
+            mActorSlots[slot].actor = nullptr;
+            mActorSlots[slot].generation++;
+            mFreeActorSlots.emplace_back(slot);
+        }
+    }
+
+    for (auto &layer : mDrawLayers)
+    {
+        layer.drawables.clear();
+        layer.numHoles = 0;
+    }
+
+    mColliders.clear();
+    mCollisionGrid.Clear();
+    mDeferredColliders.clear();
+    mDogs.clear();
+    mTileMap = nullptr;
+    mCat = nullptr;
+
+    for (Actor *actor : actors)
+    {
+        delete actor;
+    }
+
+    mIsReleasingScene = false;
+
+    const double releaseMs = (SDL_GetPerformanceCounter() - releaseStart) * 1000.0 / SDL_GetPerformanceFrequency();
+    const SceneArena::Stats &stats = SceneArena::Get().GetStats();
+    if (!actors.empty())
+    {
+        LOG_INFO(Core, "Scene released in %.2f ms: %zu actors, %zu arena allocations (%.1f KB)",
+                 releaseMs, actors.size(), stats.allocations, stats.bytes / 1024.0);
+    }
+
+    SceneArena::Get().Reset();
+}
+
 void Game::UnloadScene()
 {
     UnloadMenu();
@@ -116,9 +201,10 @@ void Game::UnloadScene()
     }
 }
 
-void Game::StartFade(const std::function<void()> &fadeCallback)
+void Game::StartFade(const std::function<void()> &fadeCallback, const std::function<bool()> &isReady)
 {
     mFadeCallback = fadeCallback;
+    mFadeReady = isReady;
     mIsFading = true;
     mFadeValue = 0.f;
     mIsFadeIn = true;
@@ -132,6 +218,10 @@ void Game::Fade(const float deltaTime)
     {
         if (mFadeValue == 1.f)
         {
+            // Hold on black until whatever the callback needs has been prepared
+            if (mFadeReady && !mFadeReady())
+                return;
+
             mIsFadeIn = false;
             mFadeCallback();
         }
@@ -151,176 +241,93 @@ void Game::SetScene(GameScene nextScene)
     switch (nextScene)
     {
     case GameScene::Level1:
-    {
-        StartFade([this]
-                  {
-                // Todo: initialize Level1
-                int **level = LoadLevel("../Assets/Levels/Level1/level1.csv", 45, 15);
-                BuildLevel(level, 45, 15);
-
-                InitializeCore();
-
-                mDialogManager->PlayDialog(DialogKeys::FASE1);
-
-                // todo: condition for level change
-                SetConditionForLevelChange([this]
-                {
-                    if (mCat)
-                        return mCat->GetPosition().x > TILE_SIZE*45;
-                    return false;
-                }); });
+        PrepareLevel("../Assets/Levels/Level1/level1.csv", 45, 15, DialogKeys::FASE1);
         break;
-    }
     case GameScene::Level2:
-    {
-
-        StartFade([this]
-                  {
-                int **level = LoadLevel("../Assets/Levels/Level2/level2.csv", 15, 45);
-                BuildLevel(level, 15, 45);
-
-                InitializeCore();
-
-                mDialogManager->PlayDialog(DialogKeys::FASE2);
-
-                SetConditionForLevelChange([this]
-                {
-                    if (mCat)
-                        return mCat->GetPosition().x > TILE_SIZE*15;
-                    return false;
-                }); });
+        PrepareLevel("../Assets/Levels/Level2/level2.csv", 15, 45, DialogKeys::FASE2);
         break;
-    }
     case GameScene::Level3:
-    {
-        StartFade([this]
-                  {
-                // Todo: initialize Level3
-                int **level = LoadLevel("../Assets/Levels/Level3/level3.csv", 45, 15);
-                BuildLevel(level, 45, 15);
-
-                InitializeCore();
-
-                mDialogManager->PlayDialog(DialogKeys::FASE3);
-
-                // todo: condition for level change
-                SetConditionForLevelChange([this]
-                {
-                    if (mCat)
-                        return mCat->GetPosition().x > TILE_SIZE*45;
-                    return false;
-                }); });
+        PrepareLevel("../Assets/Levels/Level3/level3.csv", 45, 15, DialogKeys::FASE3);
         break;
-    }
     case GameScene::Level4:
-    {
-        StartFade([this]
-                  {
-                // Todo: initialize Level4
-                int **level = LoadLevel("../Assets/Levels/Level4/level4.csv", 45, 15);
-                BuildLevel(level, 45, 15);
-
-                InitializeCore();
-
-                mDialogManager->PlayDialog(DialogKeys::FASE4);
-
-                // todo: condition for level change
-                SetConditionForLevelChange([this]
-                {
-                    if (mCat)
-                        return mCat->GetPosition().x > TILE_SIZE*45;
-                    return false;
-                }); });
+        PrepareLevel("../Assets/Levels/Level4/level4.csv", 45, 15, DialogKeys::FASE4);
         break;
-    }
     case GameScene::Level5:
-    {
-        StartFade([this]
-                  {
-                // Todo: initialize Level5
-                int **level = LoadLevel("../Assets/Levels/Level5/level5.csv", 15, 45);
-                BuildLevel(level, 15, 45);
-
-                InitializeCore();
-
-                mDialogManager->PlayDialog(DialogKeys::FASE5);
-
-                // todo: condition for level change
-                SetConditionForLevelChange([this]
-                {
-                    if (mCat)
-                        return mCat->GetPosition().x > TILE_SIZE*15;
-                    return false;
-                }); });
+        PrepareLevel("../Assets/Levels/Level5/level5.csv", 15, 45, DialogKeys::FASE5);
         break;
-    }
     default:
+        // Nothing to fade into, so the old scene goes right away
+        ReleaseScene();
         break;
     }
 }
 
-void Game::InitializeActors()
+void Game::PrepareLevel(const std::string &fileName, int width, int height, DialogKeys dialogKey)
 {
-}
+    // Textures decode on the renderer's workers, so asking now overlaps them with the fade
+    mRenderer->GetTexture(BLOCK_BORDER_TEXTURE);
+    mRenderer->GetTexture(BLOCK_INTERNAL_TEXTURE);
+    mRenderer->GetTexture(MANAGEABLE_BLOCK_TEXTURE);
 
-int **Game::LoadLevel(const std::string &fileName, int width, int height)
-{
-    // Aloca a matriz de inteiros (height x width)
-    int **level = new int *[height];
-    for (int i = 0; i < height; i++)
+    // File parsing only touches the data it returns, so it runs off the main thread
+    mPreparedLevel = std::async(std::launch::async, [fileName, width, height]
     {
-        level[i] = new int[width];
-    }
+        PreparedLevel prepared;
+        prepared.level = LevelCache::Load(fileName, width, height);
+        prepared.dialogs = DialogManager::Load("../Assets/Dialogs.json");
+        return prepared;
+    });
 
-    // Abre o arquivo CSV
-    std::ifstream file(fileName);
-    if (!file.is_open())
+    StartFade([this, width, dialogKey]
     {
-        SDL_Log("Erro ao abrir o arquivo: %s", fileName.c_str());
-        return nullptr;
-    }
-
-    // Lê o arquivo linha por linha
-    std::string line;
-    int row = 0;
+        // The screen is black: the old scene can go
+        ReleaseScene();
 
-    while (std::getline(file, line) && row < height)
-    {
-        // Usa o CSVHelper para separar os valores
-        std::vector<int> values = CSVHelper::Split(line, ',');
-
-        // Preenche a linha da matriz
-        for (int col = 0; col < width && col < values.size(); col++)
+        PreparedLevel prepared = mPreparedLevel.get();
+        if (prepared.level)
         {
-            level[row][col] = values[col];
+            const Uint64 buildStart = SDL_GetPerformanceCounter();
+            BuildLevel(*prepared.level);
+            const double buildMs = (SDL_GetPerformanceCounter() - buildStart) * 1000.0 / SDL_GetPerformanceFrequency();
+
+            const SceneArena::Stats &stats = SceneArena::Get().GetStats();
+            LOG_INFO(Core, "Level built in %.2f ms: %zu actors, %zu arena allocations (%.1f KB in %zu blocks)",
+                     buildMs, mActors.size() + mPendingActors.size(), stats.allocations, stats.bytes / 1024.0, stats.blocks);
         }
 
-        row++;
-    }
+        InitializeCore(std::move(prepared.dialogs));
 
-    file.close();
+        mDialogManager->PlayDialog(dialogKey);
 
-    // Imprime a matriz para verificação
-    SDL_Log("=== Level carregado de %s ===", fileName.c_str());
-    for (int i = 0; i < height; i++)
-    {
-        std::string rowStr = "";
-        for (int j = 0; j < width; j++)
+        SetConditionForLevelChange([this, width]
         {
-            rowStr += std::to_string(level[i][j]);
-            if (j < width - 1)
-                rowStr += ",";
-        }
-    }
+            if (mCat)
+                return mCat->GetPosition().x > TILE_SIZE * width;
+            return false;
+        });
+    }, [this]
+    {
+        return mPreparedLevel.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+}
 
-    return level;
+void Game::InitializeActors()
+{
 }
 
-void Game::BuildLevel(int **levelData, int width, int height)
+void Game::BuildLevel(const LevelGrid &level)
 {
+    const int width = level.width;
+    const int height = level.height;
+
     // auto *bg = new Background(this, "Background", "../Assets/Sprites/Background.jpg");
     // bg->SetPosition(Vector2(3408, 210));
 
+    // Plain ground tiles are only data; everything else below becomes an actor
+    auto *tileMap = new TileMap(this, "TileMap", width, height);
+    tileMap->SetTileTexture(1, mRenderer->GetTexture(BLOCK_BORDER_TEXTURE));
+    tileMap->SetTileTexture(2, mRenderer->GetTexture(BLOCK_INTERNAL_TEXTURE));
+
     // Percorre a matriz de tiles
     int objNum = 0;
     int managebleCounter = 0;
@@ -329,7 +336,7 @@ void Game::BuildLevel(int **levelData, int width, int height)
         for (int row = 0; row < height; row++)
 
         {
-            int tileID = levelData[row][col];
+            int tileID = level.GetTile(col, row);
 
             int posX = col * TILE_SIZE;
             int posY = row * TILE_SIZE;
@@ -340,16 +347,14 @@ void Game::BuildLevel(int **levelData, int width, int height)
             {
             case 0:
                 // bloco manageable
-                NewBlock = new Block(this, "Block" + std::to_string(managebleCounter), "../Assets/Sprites/Blocks/BlockJ.png", true, true);
+                NewBlock = new Block(this, "Block" + std::to_string(managebleCounter), MANAGEABLE_BLOCK_TEXTURE, true, true);
                 managebleCounter = managebleCounter + 1;
                 break;
             case 1:
                 // Chão bordas
-                NewBlock = new Block(this, "Block" + std::to_string(objNum), "../Assets/Sprites/Blocks/BlockBorder.png");
-                break;
             case 2:
                 // Chão interno
-                NewBlock = new Block(this, "Block" + std::to_string(objNum), "../Assets/Sprites/Blocks/BlockInternal.png");
+                tileMap->SetTile(col, row, tileID);
                 break;
             case 3:
             {
@@ -387,35 +392,116 @@ void Game::BuildLevel(int **levelData, int width, int height)
 
 void Game::RunLoop()
 {
+    if (mIsHeadless)
+    {
+        RunHeadlessLoop();
+        return;
+    }
+
+    const double counterFrequency = static_cast<double>(SDL_GetPerformanceFrequency());
+
     while (mIsRunning)
     {
-        // Calculate delta time in seconds
-        float deltaTime = (SDL_GetTicks() - mTicksCount) / 1000.0f;
-        if (deltaTime > 0.05f)
+        // Real time since last frame, in seconds
+        const Uint64 now = SDL_GetPerformanceCounter();
+        float frameTime = static_cast<float>((now - mLastFrameCounter) / counterFrequency);
+        mLastFrameCounter = now;
+
+        // Past this the game slows down rather than trying to catch up
+        if (frameTime > MAX_FRAME_TIME)
         {
-            deltaTime = 0.05f;
+            frameTime = MAX_FRAME_TIME;
         }
 
-        mTicksCount = SDL_GetTicks();
-
         ProcessInput();
-        UpdateGame(deltaTime);
+
+        // Simulate in fixed steps regardless of render rate
+        mAccumulator += frameTime;
+        while (mAccumulator >= mTickDeltaTime)
+        {
+            ProcessActorInput();
+            UpdateGame(mTickDeltaTime);
+            mAccumulator -= mTickDeltaTime;
+        }
+
+        // Draw between the last two ticks
+        mRenderAlpha = mAccumulator / mTickDeltaTime;
         GenerateOutput();
 
-        // Sleep to maintain frame rate
-        int sleepTime = (1000 / FPS) - (SDL_GetTicks() - mTicksCount);
-        if (sleepTime > 0)
+        // Without vsync nothing else caps the frame rate, so sleep off the rest of the frame
+        if (!mRenderer->HasVSync())
         {
-            SDL_Delay(sleepTime);
+            const double elapsedMs = (SDL_GetPerformanceCounter() - now) * 1000.0 / counterFrequency;
+            const double remainingMs = 1000.0 / FPS - elapsedMs;
+            if (remainingMs >= 1.0)
+            {
+                SDL_Delay(static_cast<Uint32>(remainingMs));
+            }
         }
     }
 }
 
-void Game::InitializeCore()
+void Game::SetTickRate(int ticksPerSecond)
+{
+    if (ticksPerSecond <= 0)
+        return;
+
+    mTickDeltaTime = 1.0f / static_cast<float>(ticksPerSecond);
+    mAccumulator = 0.f;
+}
+
+void Game::RunHeadlessLoop()
+{
+    int ticks = 0;
+    long long sprites = 0;
+    long long drawCalls = 0;
+    long long stateChanges = 0;
+    long long visible = 0;
+    long long culled = 0;
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    // Every tick is rendered at its final state
+    mRenderAlpha = 1.f;
+
+    while (mIsRunning && (mTickLimit <= 0 || ticks < mTickLimit))
+    {
+        ProcessInput();
+        ProcessActorInput();
+        UpdateGame(mTickDeltaTime);
+        GenerateOutput();
+
+        const RenderStats &stats = mRenderer->GetFrameStats();
+        sprites += stats.sprites;
+        drawCalls += stats.drawCalls;
+        stateChanges += stats.stateChanges;
+        visible += mCullStats.visible;
+        culled += mCullStats.culled;
+        ticks++;
+    }
+    const double seconds = static_cast<double>(SDL_GetPerformanceCounter() - start) /
+                           static_cast<double>(SDL_GetPerformanceFrequency());
+
+    if (ticks > 0)
+    {
+        LOG_INFO(Core, "Headless: %d ticks in %.3f s (%.1f ticks/s)", ticks, seconds, seconds > 0.0 ? ticks / seconds : 0.0);
+        LOG_INFO(Core, "Headless: avg per tick: %.1f sprites, %.1f draw calls, %.1f state changes",
+                static_cast<double>(sprites) / ticks, static_cast<double>(drawCalls) / ticks,
+                static_cast<double>(stateChanges) / ticks);
+        LOG_INFO(Core, "Headless: avg per tick: %.1f drawables visible, %.1f culled",
+                static_cast<double>(visible) / ticks, static_cast<double>(culled) / ticks);
+    }
+
+    if (Profiler::IsEnabled())
+    {
+        Profiler::WriteChromeTrace("miaoware_trace.json");
+    }
+}
+
+void Game::InitializeCore(std::shared_ptr<const DialogTable> dialogs)
 {
     mObjManager = new ObjectManager(this);
     mTerminal = new Terminal(mRenderer);
-    mDialogManager = new DialogManager(mTerminal);
+    mDialogManager = new DialogManager(mTerminal, std::move(dialogs));
 }
 
 void Game::UnloadMenu()
@@ -446,6 +532,8 @@ void Game::UnloadMenu()
 
 void Game::ProcessInput()
 {
+    PROFILE_SCOPE("Game::ProcessInput");
+
     if (mIsFading)
         return;
 
@@ -466,6 +554,14 @@ void Game::ProcessInput()
 
         mTerminal->ProcessEvent(event);
     }
+}
+
+void Game::ProcessActorInput()
+{
+    PROFILE_SCOPE("Game::ProcessActorInput");
+
+    if (mIsFading)
+        return;
 
     if (mCurrentScene == GameScene::MainMenu)
         return;
@@ -517,6 +613,10 @@ void Game::GoToNextScene()
 
 void Game::UpdateGame(float deltaTime)
 {
+    PROFILE_SCOPE("Game::UpdateGame");
+
+    SnapshotTransforms();
+
     // SDL_Log("%f %f", mCameraPos.x, mCameraPos.y);
     if (mIsFading)
     {
@@ -533,7 +633,7 @@ void Game::UpdateGame(float deltaTime)
     if (mCurrentScene == GameScene::MainMenu)
         return;
 
-    SDL_Log("%f %f", mCat->GetPosition().x, mCat->GetPosition().y);
+    LOG_TRACE(Gameplay, "Cat at %f %f", mCat->GetPosition().x, mCat->GetPosition().y);
     if (mLevelChangeCondition())
     {
         GoToNextScene();
@@ -552,17 +652,44 @@ void Game::UpdateGame(float deltaTime)
     // Update camera position
     UpdateCamera();
 
-    std::string command = mTerminal->ConsumeCommand();
-    if (!command.empty())
+    // Every submitted line runs this frame, and a line may hold several commands
+    std::string command;
+    while (mTerminal->ConsumeCommand(command))
     {
-        SDL_Log("Terminal command: %s", command.c_str());
-        ProcessTerminalCommand(command);
+        LOG_DEBUG(Terminal, "Terminal command: %s", command.c_str());
+        mCommands.Execute(command);
+    }
+
+    // Edits from this frame's commands land together, after the simulation step
+    mObjManager->ApplyPendingEdits();
+}
+
+void Game::SnapshotTransforms()
+{
+    mPrevCameraPos = mCameraPos;
+
+    for (auto actor : mActors)
+    {
+        actor->SnapshotTransform();
     }
 }
 
 void Game::UpdateActors(float deltaTime)
 {
+    PROFILE_SCOPE("Game::UpdateActors");
+
     mUpdatingActors = true;
+
+    // Pooled components are ticked one type at a time (physics, then animation), before the actors
+    ComponentPool<RigidBodyComponent>::Get().ForEach([deltaTime](RigidBodyComponent *rigidBody) {
+        if (rigidBody->ShouldUpdate())
+            rigidBody->Update(deltaTime);
+    });
+    ComponentPool<AnimatorComponent>::Get().ForEach([deltaTime](AnimatorComponent *animator) {
+        if (animator->ShouldUpdate())
+            animator->Update(deltaTime);
+    });
+
     for (auto actor : mActors)
     {
         actor->Update(deltaTime);
@@ -571,23 +698,35 @@ void Game::UpdateActors(float deltaTime)
 
     for (auto pending : mPendingActors)
     {
+        pending->mActorIndex = static_cast<int>(mActors.size());
+        pending->mIsPendingActor = false;
         mActors.emplace_back(pending);
     }
     mPendingActors.clear();
 
-    std::vector<Actor *> deadActors;
+    // Compact the survivors in a single pass and detach the dead ones, so their
+    // destructors don't have to search for themselves in mActors
+    size_t numAlive = 0;
     for (auto actor : mActors)
     {
         if (actor->GetState() == ActorState::Destroy)
         {
-            deadActors.emplace_back(actor);
+            actor->mActorIndex = -1;
+            mDeadActors.emplace_back(actor);
+        }
+        else
+        {
+            actor->mActorIndex = static_cast<int>(numAlive);
+            mActors[numAlive++] = actor;
         }
     }
+    mActors.resize(numAlive);
 
-    for (auto actor : deadActors)
+    for (auto actor : mDeadActors)
     {
         delete actor;
     }
+    mDeadActors.clear();
 }
 
 void Game::UpdateCamera()
@@ -601,64 +740,189 @@ void Game::UpdateCamera()
     SetCameraPos(clampedPos);
 }
 
+Vector2 Game::GetRenderCameraPos() const
+{
+    return Vector2::Lerp(mPrevCameraPos, mCameraPos, mRenderAlpha);
+}
+
 void Game::AddActor(Actor *actor)
 {
-    if (mUpdatingActors)
+    uint32_t slot;
+    if (!mFreeActorSlots.empty())
     {
-        mPendingActors.emplace_back(actor);
+        slot = mFreeActorSlots.back();
+        mFreeActorSlots.pop_back();
     }
     else
     {
-        mActors.emplace_back(actor);
+        slot = static_cast<uint32_t>(mActorSlots.size());
+        mActorSlots.emplace_back(ActorSlot{nullptr, 0});
     }
+    mActorSlots[slot].actor = actor;
+    actor->mHandle = ActorHandle{slot, mActorSlots[slot].generation};
+
+    auto &actors = mUpdatingActors ? mPendingActors : mActors;
+    actor->mActorIndex = static_cast<int>(actors.size());
+    actor->mIsPendingActor = mUpdatingActors;
+    actors.emplace_back(actor);
 }
 
 void Game::RemoveActor(Actor *actor)
 {
-    auto iter = std::find(mPendingActors.begin(), mPendingActors.end(), actor);
-    if (iter != mPendingActors.end())
+    if (mIsReleasingScene)
+        return;
+
+    if (actor->mIsManageable && mObjManager)
+    {
+        mObjManager->OnActorRemoved(actor);
+    }
+
+    // Actors batched out by UpdateActors are already detached from the list
+    if (actor->mActorIndex >= 0)
     {
-        // Swap to end of vector and pop off (avoid erase copies)
-        std::iter_swap(iter, mPendingActors.end() - 1);
-        mPendingActors.pop_back();
+        // Swap with the last actor and pop off (avoid erase copies)
+        auto &actors = actor->mIsPendingActor ? mPendingActors : mActors;
+        Actor *last = actors.back();
+        actors[actor->mActorIndex] = last;
+        last->mActorIndex = actor->mActorIndex;
+        actors.pop_back();
+        actor->mActorIndex = -1;
     }
 
-    iter = std::find(mActors.begin(), mActors.end(), actor);
-    if (iter != mActors.end())
+    const uint32_t slot = actor->mHandle.index;
+    if (slot < mActorSlots.size() && mActorSlots[slot].actor == actor)
     {
-        // Swap to end of vector and pop off (avoid erase copies)
-        std::iter_swap(iter, mActors.end() - 1);
-        mActors.pop_back();
+        mActorSlots[slot].actor = nullptr;
+        mActorSlots[slot].generation++;
+        mFreeActorSlots.emplace_back(slot);
     }
+    actor->mHandle = ActorHandle{};
+}
+
+Actor *Game::GetActor(ActorHandle handle) const
+{
+    if (handle.index >= mActorSlots.size())
+        return nullptr;
+
+    const ActorSlot &slot = mActorSlots[handle.index];
+    return slot.generation == handle.generation ? slot.actor : nullptr;
 }
 
 void Game::AddDrawable(class DrawComponent *drawable)
 {
-    mDrawables.emplace_back(drawable);
+    // Only a handful of distinct draw orders exist, so layers are looked up in a small sorted vector
+    const int drawOrder = drawable->GetDrawOrder();
+    auto layer = std::lower_bound(mDrawLayers.begin(), mDrawLayers.end(), drawOrder,
+                                  [](const DrawLayer &l, int order) { return l.drawOrder < order; });
+    if (layer == mDrawLayers.end() || layer->drawOrder != drawOrder)
+    {
+        layer = mDrawLayers.insert(layer, DrawLayer{drawOrder, {}, 0});
+    }
 
-    std::sort(mDrawables.begin(), mDrawables.end(), [](DrawComponent *a, DrawComponent *b)
-              { return a->GetDrawOrder() < b->GetDrawOrder(); });
+    drawable->mDrawIndex = static_cast<int>(layer->drawables.size());
+    layer->drawables.emplace_back(drawable);
 }
 
 void Game::RemoveDrawable(class DrawComponent *drawable)
 {
-    auto iter = std::find(mDrawables.begin(), mDrawables.end(), drawable);
-    mDrawables.erase(iter);
+    if (mIsReleasingScene)
+        return;
+
+    auto layer = std::lower_bound(mDrawLayers.begin(), mDrawLayers.end(), drawable->GetDrawOrder(),
+                                  [](const DrawLayer &l, int order) { return l.drawOrder < order; });
+    if (layer == mDrawLayers.end() || drawable->mDrawIndex < 0)
+        return;
+
+    layer->drawables[drawable->mDrawIndex] = nullptr;
+    layer->numHoles++;
+    drawable->mDrawIndex = -1;
+}
+
+void Game::CompactDrawLayers()
+{
+    for (auto &layer : mDrawLayers)
+    {
+        if (layer.numHoles == 0)
+            continue;
+
+        int write = 0;
+        for (auto *drawable : layer.drawables)
+        {
+            if (!drawable)
+                continue;
+
+            drawable->mDrawIndex = write;
+            layer.drawables[write++] = drawable;
+        }
+        layer.drawables.resize(write);
+        layer.numHoles = 0;
+    }
 }
 
 void Game::AddCollider(class AABBColliderComponent *collider)
 {
+    collider->mColliderIndex = static_cast<int>(mColliders.size());
     mColliders.emplace_back(collider);
+    mCollisionGrid.Insert(collider);
 }
 
 void Game::RemoveCollider(AABBColliderComponent *collider)
 {
-    auto iter = std::find(mColliders.begin(), mColliders.end(), collider);
-    mColliders.erase(iter);
+    if (mIsReleasingScene)
+        return;
+
+    mCollisionGrid.Remove(collider);
+
+    if (mDeferColliderUpdates)
+    {
+        mDeferredColliders.erase(std::remove(mDeferredColliders.begin(), mDeferredColliders.end(), collider),
+                                 mDeferredColliders.end());
+    }
+
+    if (collider->mColliderIndex < 0)
+        return;
+
+    // Swap with the last collider and pop off (order doesn't matter, queries go through the grid)
+    AABBColliderComponent *last = mColliders.back();
+    mColliders[collider->mColliderIndex] = last;
+    last->mColliderIndex = collider->mColliderIndex;
+    mColliders.pop_back();
+    collider->mColliderIndex = -1;
+}
+
+void Game::UpdateCollider(AABBColliderComponent *collider)
+{
+    if (mDeferColliderUpdates)
+    {
+        mDeferredColliders.emplace_back(collider);
+        return;
+    }
+
+    mCollisionGrid.Update(collider);
+}
+
+void Game::SetDeferColliderUpdates(const bool defer)
+{
+    mDeferColliderUpdates = defer;
+    if (defer)
+        return;
+
+    // A collider touched several times in the batch only needs its final box filed
+    std::sort(mDeferredColliders.begin(), mDeferredColliders.end());
+    mDeferredColliders.erase(std::unique(mDeferredColliders.begin(), mDeferredColliders.end()),
+                             mDeferredColliders.end());
+
+    for (AABBColliderComponent *collider : mDeferredColliders)
+    {
+        mCollisionGrid.Update(collider);
+    }
+    mDeferredColliders.clear();
 }
 
 void Game::GenerateOutput()
 {
+    PROFILE_SCOPE("Game::GenerateOutput");
+
     // Clear back buffer
     mRenderer->Clear();
 
@@ -669,15 +933,35 @@ void Game::GenerateOutput()
     }
     else
     {
-        for (auto drawable : mDrawables)
-        {
-            drawable->Draw(mRenderer);
+        CompactDrawLayers();
+
+        // Anything whose box is fully outside the view isn't submitted
+        const Vector2 viewMin = GetRenderCameraPos();
+        const Vector2 viewMax = viewMin + Vector2(static_cast<float>(WINDOW_WIDTH), static_cast<float>(WINDOW_HEIGHT));
+        mCullStats = CullStats();
 
-            if (mIsDebugging)
+        for (const auto &layer : mDrawLayers)
+        {
+            for (auto drawable : layer.drawables)
             {
-                for (auto comp : drawable->GetOwner()->GetComponents())
+                Vector2 boundsMin, boundsMax;
+                if (drawable->GetWorldBounds(boundsMin, boundsMax) &&
+                    (boundsMax.x < viewMin.x || boundsMin.x > viewMax.x ||
+                     boundsMax.y < viewMin.y || boundsMin.y > viewMax.y))
                 {
-                    comp->DebugDraw(mRenderer);
+                    mCullStats.culled++;
+                    continue;
+                }
+
+                mCullStats.visible++;
+                drawable->Draw(mRenderer);
+
+                if (mIsDebugging)
+                {
+                    for (auto comp : drawable->GetOwner()->GetComponents())
+                    {
+                        comp->DebugDraw(mRenderer);
+                    }
                 }
             }
         }
@@ -691,21 +975,22 @@ void Game::GenerateOutput()
 
 void Game::Shutdown()
 {
-    while (!mActors.empty())
+    ReleaseScene();
+    SceneArena::Get().Release();
+    LevelCache::Clear();
+
+    // Fonts own GL textures (glyph atlases), so release them while the context is alive
+    if (mTerminal)
     {
-        delete mActors.back();
+        delete mTerminal;
+        mTerminal = nullptr;
     }
-
-    // Delete level data
-    if (mLevelData)
+    if (mMainMenu)
     {
-        for (int i = 0; i < LEVEL_HEIGHT; ++i)
-        {
-            delete[] mLevelData[i];
-        }
-        delete[] mLevelData;
-        mLevelData = nullptr;
+        delete mMainMenu;
+        mMainMenu = nullptr;
     }
+    mUiFont.reset();
 
     mRenderer->Shutdown();
     delete mRenderer;
@@ -721,136 +1006,162 @@ void Game::Shutdown()
         mAudio = nullptr;
     }
 
-    if (mMainMenu)
+    if (mWindow)
     {
-        delete mMainMenu;
-        mMainMenu = nullptr;
+        SDL_DestroyWindow(mWindow);
     }
-
-    SDL_DestroyWindow(mWindow);
     SDL_Quit();
 }
 
-void Game::ProcessTerminalCommand(const std::string &input)
+void Game::RegisterTerminalCommands()
 {
-    std::string command = input;
-    std::transform(command.begin(), command.end(), command.begin(), ::tolower);
-
-    // Usa stringstream para dividir a linha em tokens (palavra por palavra)
-    std::stringstream ss(command);
-    std::string verb;             // O comando principal (ex: jump, set, get, add)
-    std::string arg1, arg2, arg3; // Argumentos (ex: ACTOR_NAME, ATTRIBUTE, VALUE)
-
-    ss >> verb; // Lê o primeiro token (o comando/verbo)
+    mCommands.SetOutput([this](const std::string &line)
+    {
+        if (mTerminal)
+            mTerminal->AddLine(line);
+        else
+            LOG_INFO(Terminal, "%s", line.c_str());
+    });
 
-    if (verb == "jump")
+    mCommands.Register("jump", {}, {}, 0, "Usage: jump", [this](const CommandArgs &)
     {
         mObjManager->Jump();
-    }
-    else if (verb == "get")
+    });
+
+    mCommands.Register("get", {}, {CommandArgType::Word}, 1, "Usage: GET <Object Name>", [this](const CommandArgs &args)
     {
-        if (ss >> arg1)
-        {
-            std::string attributes = mObjManager->GetObjAttributes(arg1);
-            mTerminal->AddLine(attributes);
-        }
-        else
-        {
-            mTerminal->AddLine("Usage: GET <Object Name>");
-        }
-    }
-    else if (verb == "set")
+        mCommands.Print(mObjManager->GetObjAttributes(args[0].text));
+    });
+
+    mCommands.Register("set", {}, {CommandArgType::Word, CommandArgType::Word, CommandArgType::Value}, 3,
+                       "Usage: set <Object Name|Selector> <Attribute> <Value>", [this](const CommandArgs &args)
     {
-        if (ss >> arg1 >> arg2 >> arg3)
+        const std::string_view objName = args[0].text;
+        const std::string_view attribute = args[1].text;
+        const CommandArg &value = args[2];
+
+        if (MatchesCmd(attribute, "rotation"))
         {
-            std::string originalValue = input.substr(input.find(arg3.substr(0, 1)));
-            if (arg2 == "rotation")
+            if (value.type != CommandArgType::Number)
             {
-                if (!ValidateNumber(arg3))
-                {
-                    mTerminal->AddLine("Error: rotation must be a single number. Example: 45");
-                    return;
-                }
+                mCommands.Print("Error: rotation must be a single number. Example: 45");
+                return;
             }
-            else if (MatchesCmd(arg2, "scale") || MatchesCmd(arg2, "position"))
+            mObjManager->SetRotation(objName, value.number);
+        }
+        else if (MatchesCmd(attribute, "scale") || MatchesCmd(attribute, "position"))
+        {
+            if (value.type != CommandArgType::Vector2)
             {
-                if (!ValidateVector2(arg3))
-                {
-                    mTerminal->AddLine("Error: value must be in format (x,y). Example: (1,2)");
-                    return;
-                }
+                mCommands.Print("Error: value must be in format (x,y). Example: (1,2)");
+                return;
             }
-            else if (arg2 == "damage")
+
+            if (MatchesCmd(attribute, "scale"))
+                mObjManager->SetScale(objName, value.vector);
+            else
+                mObjManager->SetPosition(objName, value.vector);
+        }
+        else if (MatchesCmd(attribute, "damage"))
+        {
+            if (value.type != CommandArgType::Number)
             {
-                if (!ValidateNumber(arg3))
-                {
-                    mTerminal->AddLine("Error: damage must be a single number. Example: 0");
-                    return;
-                }
+                mCommands.Print("Error: damage must be a single number. Example: 0");
+                return;
             }
-            mObjManager->SetAttributeValue(arg1, arg2, arg3);
+
+            if (value.number == 0.0f)
+                mObjManager->DisableDamage(objName);
+            else
+                mObjManager->EnableDamage(objName);
         }
         else
         {
-            mTerminal->AddLine("Usage: set <Object Name> <Attribute> <Value>");
+            mCommands.Print("Error: unknown attribute '" + std::string(attribute) + "'. Use rotation, position, scale or damage");
         }
-    }
-    else if (verb == "list")
+    });
+
+    mCommands.Register("list", {"ls"}, {CommandArgType::Word}, 0, "Usage: list [Selector]", [this](const CommandArgs &args)
     {
-        std::vector<std::string_view> names = mObjManager->GetAllObjNames();
         std::string listStr = "Manageable Objects: ";
-        for (const auto &name : names)
-        {
-            listStr += std::string(name) + " ";
-        }
-        mTerminal->AddLine(listStr);
-    }
-    else if (verb == "delete")
-    {
-        if (ss >> arg1)
+        if (!args.Has(0))
         {
-            mObjManager->DeleteObject(arg1);
+            for (const auto &name : mObjManager->GetAllObjNames())
+            {
+                listStr.append(name).append(" ");
+            }
         }
         else
         {
-            mTerminal->AddLine("Usage: delete <Object Name>");
+            std::vector<Actor *> actors;
+            if (!mObjManager->Select(args[0].text, actors))
+            {
+                mCommands.Print("Error: invalid selector. Example: block*, dog[0-9], @inrect(0,0,640,480)");
+                return;
+            }
+            for (const Actor *actor : actors)
+            {
+                listStr.append(actor->GetActorName()).append(" ");
+            }
         }
-    }
-    else
-    {
-        mTerminal->AddLine("Unknown command: " + command);
-    }
-}
+        mCommands.Print(listStr);
+    });
 
-bool Game::ValidateNumber(const std::string &value)
-{
-    char *end;
-    std::strtod(value.c_str(), &end);
-    return end != value.c_str() && *end == '\0';
-}
+    mCommands.Register("trace", {}, {CommandArgType::Word}, 0, "Usage: trace [file]", [this](const CommandArgs &args)
+    {
+        if (!Profiler::IsEnabled())
+        {
+            mCommands.Print("Profiling is disabled in this build (configure with MIAOWARE_PROFILING=ON)");
+            return;
+        }
 
-bool Game::ValidateVector2(const std::string &value)
-{
-    if (value.size() < 5 || value.front() != '(' || value.back() != ')')
-        return false;
+        const std::string path = args.Has(0) ? std::string(args[0].text) : "miaoware_trace.json";
+        mCommands.Print(Profiler::WriteChromeTrace(path) ? "Trace written to " + path
+                                                          : "Error: could not write " + path);
+    });
 
-    std::string inside = value.substr(1, value.size() - 2);
+    // Runtime log filter, e.g. "log audio debug"; with no arguments shows every category's level
+    mCommands.Register("log", {}, {CommandArgType::Word, CommandArgType::Word}, 0, "Usage: log [Category] [Level]",
+                       [this](const CommandArgs &args)
+    {
+        if (!args.Has(0))
+        {
+            std::string levels = "Log levels: ";
+            for (int i = 0; i < static_cast<int>(LogCategory::Count); i++)
+            {
+                const auto category = static_cast<LogCategory>(i);
+                levels.append(Log::GetCategoryName(category)).append("=").append(Log::GetLevelName(Log::GetLevel(category))).append(" ");
+            }
+            mCommands.Print(levels);
+            return;
+        }
 
-    size_t comma = inside.find(',');
-    if (comma == std::string::npos)
-        return false;
+        LogCategory category;
+        LogLevel level;
+        if (!args.Has(1) || !Log::ParseCategory(std::string(args[0].text).c_str(), category) ||
+            !Log::ParseLevel(std::string(args[1].text).c_str(), level))
+        {
+            mCommands.Print("Usage: log <Core|Render|Audio|Gameplay|Terminal> <TRACE|DEBUG|INFO|WARN|ERROR|OFF>");
+            return;
+        }
 
-    std::string x = inside.substr(0, comma);
-    std::string y = inside.substr(comma + 1);
+        Log::SetLevel(category, level);
+    });
 
-    auto isNumber = [](const std::string &s)
+    mCommands.Register("delete", {"rm"}, {CommandArgType::Word}, 1, "Usage: delete <Object Name|Selector>", [this](const CommandArgs &args)
     {
-        char *end;
-        std::strtod(s.c_str(), &end);
-        return end != s.c_str() && *end == '\0';
-    };
+        mObjManager->DeleteObject(args[0].text);
+    });
 
-    return isNumber(x) && isNumber(y);
+    // Runs a file of commands (one per line or ';'-separated) in the current frame
+    mCommands.Register("run", {"exec"}, {CommandArgType::Word}, 1, "Usage: run <Script File>", [this](const CommandArgs &args)
+    {
+        const std::string path(args[0].text);
+        if (!mCommands.ExecuteFile(path))
+        {
+            mCommands.Print("Error: could not read " + path);
+        }
+    });
 }
 
 void Game::RestartLevel()
@@ -10,8 +10,14 @@
 #include <SDL.h>
 #include <vector>
 #include "Renderer/Renderer.h"
+#include "Components/Physics/CollisionGrid.h"
+#include "Actors/ActorHandle.h"
 #include <algorithm>
 #include <functional>
+#include <future>
+#include <memory>
+#include "Utils/DialogManager.h"
+#include "Utils/CommandDispatcher.h"
 
 enum class GameScene
 {
@@ -28,7 +34,7 @@ class Dog;
 class Game
 {
 public:
-    Game();
+    explicit Game(bool isHeadless = false);
 
     bool Initialize();
     void RunLoop();
@@ -40,6 +46,8 @@ public:
     void UpdateActors(float deltaTime);
     void AddActor(class Actor *actor);
     void RemoveActor(class Actor *actor);
+    // Returns the actor the handle refers to, or null if it was destroyed
+    class Actor *GetActor(ActorHandle handle) const;
 
     // Renderer
     class Renderer *GetRenderer() { return mRenderer; }
@@ -55,30 +63,57 @@ public:
     static const int TILE_SIZE = 32;
     static const int SPAWN_DISTANCE = 700;
     static const int FPS = 60;
+    static constexpr float MAX_FRAME_TIME = 0.25f;
 
     // Draw functions
     void AddDrawable(class DrawComponent *drawable);
     void RemoveDrawable(class DrawComponent *drawable);
-    std::vector<class DrawComponent *> &GetDrawables() { return mDrawables; }
 
     // Collider functions
     void AddCollider(class AABBColliderComponent *collider);
     void RemoveCollider(class AABBColliderComponent *collider);
+    void UpdateCollider(class AABBColliderComponent *collider);
+    // While deferred, moved colliders are re-filed in the grid once, when deferral ends
+    void SetDeferColliderUpdates(bool defer);
     std::vector<class AABBColliderComponent *> &GetColliders() { return mColliders; }
+    CollisionGrid &GetCollisionGrid() { return mCollisionGrid; }
+
+    // Static level tiles of the current scene (null outside levels)
+    class TileMap *GetTileMap() const { return mTileMap; }
+    void SetTileMap(class TileMap *tileMap) { mTileMap = tileMap; }
 
     // Camera functions
     Vector2 &GetCameraPos() { return mCameraPos; };
     void SetCameraPos(const Vector2 &position) { mCameraPos = position; };
 
+    // Camera position interpolated between the last two ticks (for drawing)
+    Vector2 GetRenderCameraPos() const;
+
+    // Drawables submitted/skipped by camera culling in the last frame
+    struct CullStats
+    {
+        int visible = 0;
+        int culled = 0;
+    };
+    const CullStats &GetCullStats() const { return mCullStats; }
+
+    // Simulation rate, independent from how often frames are rendered
+    void SetTickRate(int ticksPerSecond);
+    float GetTickDeltaTime() const { return mTickDeltaTime; }
+
+    // Fraction of a tick elapsed since the last simulated one, in [0, 1)
+    float GetRenderAlpha() const { return mRenderAlpha; }
+
     // Game specific
     class Cat *GetPlayer() { return mCat; }
     class Terminal *GetTerminal() { return mTerminal; }
+    class ObjectManager *GetObjectManager() const { return mObjManager; }
 
-    std::vector<Actor *> GetAllActors() const { return mActors; }
+    const std::vector<Actor *> &GetAllActors() const { return mActors; }
 
     GameScene mCurrentScene = GameScene::MainMenu;
 
-    class Font* mUiFont = nullptr;
+    std::shared_ptr<class Font> mUiFont;
     class AudioSystem* mAudio = nullptr;
     class MainMenu* mMainMenu = nullptr;
 
@@ -92,27 +127,53 @@ public:
 
     void RestartLevel();
 
+    // Headless runs stop after this many ticks (0 = run until quit)
+    void SetTickLimit(int ticks) { mTickLimit = ticks; }
+    bool IsHeadless() const { return mIsHeadless; }
+
 private:
-    void InitializeCore();
+    void RunHeadlessLoop();
+
+    void InitializeCore(std::shared_ptr<const DialogTable> dialogs);
 
     void UnloadMenu();
 
+    // Destroys every actor at once: the registries are emptied first so the
+    // destructors skip unregistering, then the scene arena is rewound
+    void ReleaseScene();
+    bool mIsReleasingScene = false;
+
     void ProcessInput();
+    void ProcessActorInput();
 
     void GoToNextScene();
 
     void UpdateGame(float deltaTime);
+    void SnapshotTransforms();
     void UpdateCamera();
     void GenerateOutput();
 
     // Level loading
-    int **LoadLevel(const std::string &fileName, int width, int height);
-    void BuildLevel(int **levelData, int width, int height);
+    void BuildLevel(const struct LevelGrid &level);
 
-    bool ValidateVector2(const std::string & string);
-    bool ValidateNumber(const std::string & string);
+    // Loads the level (through LevelCache) and its dialogs on a worker while the screen fades out;
+    // the fade holds on black until they're ready, then the level is built
+    void PrepareLevel(const std::string &fileName, int width, int height, DialogKeys dialogKey);
 
-    void ProcessTerminalCommand(const std::string &input);
+    struct PreparedLevel
+    {
+        std::shared_ptr<const struct LevelGrid> level;
+        std::shared_ptr<const DialogTable> dialogs;
+    };
+    std::future<PreparedLevel> mPreparedLevel;
+
+    static constexpr const char *BLOCK_BORDER_TEXTURE = "../Assets/Sprites/Blocks/BlockBorder.png";
+    static constexpr const char *BLOCK_INTERNAL_TEXTURE = "../Assets/Sprites/Blocks/BlockInternal.png";
+    static constexpr const char *MANAGEABLE_BLOCK_TEXTURE = "../Assets/Sprites/Blocks/BlockJ.png";
+
+    // Terminal commands (see RegisterTerminalCommands)
+    CommandDispatcher mCommands;
+    void RegisterTerminalCommands();
 
     void SetConditionForLevelChange(std::function<bool()> Condition)
     {
@@ -125,23 +186,58 @@ private:
     // All the actors in the game
     std::vector<class Actor *> mActors;
     std::vector<class Actor *> mPendingActors;
+
+    // Slot table backing ActorHandle. A slot's generation is bumped when its
+    // actor is removed so outstanding handles stop resolving.
+    struct ActorSlot
+    {
+        class Actor *actor;
+        uint32_t generation;
+    };
+    std::vector<ActorSlot> mActorSlots;
+    std::vector<uint32_t> mFreeActorSlots;
+    std::vector<class Actor *> mDeadActors;
     std::vector<class Dog *> mDogs;
 
     // Camera
     Vector2 mCameraPos;
+    Vector2 mPrevCameraPos;
 
-    // All the draw components
-    std::vector<class DrawComponent *> mDrawables;
+    // All the draw components, bucketed by draw order. Removal leaves a hole
+    // that is compacted before the next draw, so insertion order is kept.
+    struct DrawLayer
+    {
+        int drawOrder;
+        std::vector<class DrawComponent *> drawables;
+        int numHoles;
+    };
+    std::vector<DrawLayer> mDrawLayers;
+    void CompactDrawLayers();
+    CullStats mCullStats;
 
     // All the collision components
     std::vector<class AABBColliderComponent *> mColliders;
 
+    // Broadphase for collider queries, one cell per tile
+    CollisionGrid mCollisionGrid;
+    bool mDeferColliderUpdates = false;
+    std::vector<class AABBColliderComponent *> mDeferredColliders;
+
+    class TileMap *mTileMap = nullptr;
+
     // SDL stuff
     SDL_Window *mWindow;
     class Renderer *mRenderer;
 
-    // Track elapsed time since game start
-    Uint32 mTicksCount;
+    // Fixed-step timing
+    Uint64 mLastFrameCounter;
+    float mTickDeltaTime;
+    float mAccumulator;
+    float mRenderAlpha;
+
+    // Headless mode: null renderer/audio, fixed dt as fast as possible
+    bool mIsHeadless;
+    int mTickLimit;
 
     // Track if we're updating actors right now
     bool mIsRunning;
@@ -150,7 +246,6 @@ private:
 
     // Game-specific
     class Cat *mCat;
-    int **mLevelData;
 
     class ObjectManager *mObjManager = nullptr;
     class Terminal *mTerminal;
@@ -161,8 +256,9 @@ private:
     bool mIsFadeIn = false;
     bool mIsFading = false;
     std::function<void()> mFadeCallback;
+    std::function<bool()> mFadeReady;
     void Fade(const float deltaTime);
-    void StartFade(const std::function<void()>& fadeCallback);
+    void StartFade(const std::function<void()>& fadeCallback, const std::function<bool()>& isReady = nullptr);
 
 public:
     float mFadeValue = 0.f;
@@ -6,18 +6,136 @@
 //  Copyright © 2017 Sanjay Madhav. All rights reserved.
 //
 
+#include <charconv>
+#include <cstring>
 #include <iostream>
+#include <string>
 
 #include "Game.h"
+#include "Utils/LevelCache.h"
+#include "Utils/Log.h"
 
+namespace
+{
+    // Whole argument must be a number that fits in an int
+    bool ParseInt(const char* text, int& outValue)
+    {
+        const char* end = text + std::strlen(text);
+        const auto result = std::from_chars(text, end, outValue);
+        return result.ec == std::errc() && result.ptr == end && result.ptr != text;
+    }
+
+    // Writes the binary form of a CSV level next to it (same name, ".lvl")
+    int ConvertLevel(const std::string& csvPath, int width, int height)
+    {
+        const auto grid = LevelCache::Load(csvPath, width, height);
+        if (!grid)
+            return 1;
+
+        const size_t dot = csvPath.find_last_of('.');
+        const size_t slash = csvPath.find_last_of("/\\");
+        const bool hasExtension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+        const std::string lvlPath = (hasExtension ? csvPath.substr(0, dot) : csvPath) + ".lvl";
+
+        if (!LevelCache::WriteBinary(*grid, lvlPath))
+        {
+            std::cerr << "Could not write " << lvlPath << std::endl;
+            return 1;
+        }
+
+        std::cout << "Wrote " << lvlPath << std::endl;
+        return 0;
+    }
+}
+
+// Usage: miaoware [--headless] [--level <1-5>] [--ticks <n>] [--tick-rate <hz>] [--log-file <path>]
+//        miaoware --convert-level <csv> <width> <height>
 int main(int argc, char** argv)
 {
-    Game game;
+    bool headless = false;
+    int level = 1;
+    int ticks = 0;
+    int tickRate = Game::FPS;
+    const char* logFile = nullptr;
+    const char* convertPath = nullptr;
+    int convertWidth = 0;
+    int convertHeight = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--headless")
+        {
+            headless = true;
+        }
+        else if (arg == "--level" || arg == "--ticks" || arg == "--tick-rate")
+        {
+            int value;
+            if (i + 1 >= argc || !ParseInt(argv[i + 1], value))
+            {
+                std::cerr << arg << " expects an integer" << std::endl;
+                return 1;
+            }
+            i++;
+
+            if (arg == "--level")
+                level = value;
+            else if (arg == "--ticks")
+                ticks = value;
+            else
+                tickRate = value;
+        }
+        else if (arg == "--log-file" && i + 1 < argc)
+        {
+            logFile = argv[++i];
+        }
+        else if (arg == "--convert-level")
+        {
+            if (i + 3 >= argc || !ParseInt(argv[i + 2], convertWidth) || !ParseInt(argv[i + 3], convertHeight) ||
+                convertWidth <= 0 || convertHeight <= 0)
+            {
+                std::cerr << "Usage: --convert-level <csv> <width> <height>" << std::endl;
+                return 1;
+            }
+            convertPath = argv[i + 1];
+            i += 3;
+        }
+        else
+        {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    // Offline conversion: no window, no game loop
+    if (convertPath)
+    {
+        return ConvertLevel(convertPath, convertWidth, convertHeight);
+    }
+
+    if (level < 1 || level > 5)
+    {
+        std::cerr << "Level must be between 1 and 5" << std::endl;
+        return 1;
+    }
+
+    Log::Start(logFile);
+
+    Game game(headless);
+    game.SetTickRate(tickRate);
     bool success = game.Initialize();
     if (success)
     {
+        if (headless)
+        {
+            // Skip the menu and go straight to the requested level
+            game.SetTickLimit(ticks);
+            game.SetScene(static_cast<GameScene>(static_cast<int>(GameScene::Level1) + level - 1));
+        }
         game.RunLoop();
     }
     game.Shutdown();
+
+    Log::Stop();
     return 0;
 }
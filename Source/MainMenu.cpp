@@ -115,17 +115,9 @@ void MainMenu::Draw(bool debug)
             if (mFont)
             {
                 std::string coords = "(" + std::to_string(mx) + ", " + std::to_string(my) + ")";
-                Texture* t = mFont->RenderText(coords.c_str(), Vector3(1,1,1), 18);
-                if (t)
-                {
-                    float tw = (float)t->GetWidth();
-                    float th = (float)t->GetHeight();
-                    Vector2 pos((float)mx + 14.0f, (float)my - th - 6.0f);
-                    r->DrawTexture(pos, Vector2(tw, th), 0.0f, Vector3(1,1,1), t,
-                                   Vector4(0,0,1,1), Vector2::Zero, false, 1.0f);
-                    t->Unload();
-                    delete t;
-                }
+                const Vector2 size = mFont->MeasureText(coords, 18);
+                const Vector2 pos((float)mx + 14.0f, (float)my - size.y - 6.0f);
+                mFont->DrawText(r, coords, pos - size * 0.5f, Vector3(1,1,1), 18);
             }
         }
     }
@@ -1,7 +1,73 @@
 #include "Font.h"
 #include "Texture.h"
+#include "Renderer.h"
+#include <algorithm>
 #include <vector>
 #include "../Game.h"
+#include "../Utils/Log.h"
+
+namespace
+{
+	// Atlas rows wrap at this width
+	const int ATLAS_WIDTH = 512;
+	// Gap between glyphs so linear filtering doesn't bleed neighbours in
+	const int GLYPH_PADDING = 2;
+
+	SDL_Color ToSDLColor(const Vector3& color)
+	{
+		SDL_Color sdlColor;
+		// Swap red and blue so we get RGBA instead of BGRA
+		sdlColor.b = static_cast<Uint8>(color.x * 255);
+		sdlColor.g = static_cast<Uint8>(color.y * 255);
+		sdlColor.r = static_cast<Uint8>(color.z * 255);
+		sdlColor.a = 255;
+		return sdlColor;
+	}
+
+	// Decodes the UTF-8 sequence at text[i] and moves i past it. Malformed
+	// bytes decode as '?' one at a time so the rest of the line survives.
+	char32_t NextCodepoint(const std::string& text, size_t& i)
+	{
+		const unsigned char lead = static_cast<unsigned char>(text[i++]);
+		if (lead < 0x80)
+			return lead;
+
+		int length = 0;
+		char32_t codepoint = 0;
+		if ((lead & 0xE0) == 0xC0)
+		{
+			length = 1;
+			codepoint = lead & 0x1F;
+		}
+		else if ((lead & 0xF0) == 0xE0)
+		{
+			length = 2;
+			codepoint = lead & 0x0F;
+		}
+		else if ((lead & 0xF8) == 0xF0)
+		{
+			length = 3;
+			codepoint = lead & 0x07;
+		}
+		else
+		{
+			return '?';
+		}
+
+		if (i + length > text.size())
+			return '?';
+
+		for (int k = 0; k < length; k++)
+		{
+			const unsigned char next = static_cast<unsigned char>(text[i + k]);
+			if ((next & 0xC0) != 0x80)
+				return '?';
+			codepoint = (codepoint << 6) | (next & 0x3F);
+		}
+		i += length;
+		return codepoint;
+	}
+}
 
 Font::Font()
 {
@@ -9,32 +75,79 @@ Font::Font()
 
 Font::~Font()
 {
+	Unload();
 }
 
 bool Font::Load(const std::string& fileName)
 {
-	// We support these font sizes
-	std::vector<int> fontSizes = {8,  9,  10, 11, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30, 32,
-								  34, 36, 38, 40, 42, 44, 46, 48, 52, 56, 60, 64, 68, 72};
+	// Keep the file in memory; each point size is opened from it on first use
+	SDL_RWops* file = SDL_RWFromFile(fileName.c_str(), "rb");
+	if (file == nullptr)
+	{
+		LOG_ERROR(Render, "Failed to load font %s", fileName.c_str());
+		return false;
+	}
 
-	for (auto& size : fontSizes)
+	const Sint64 size = SDL_RWsize(file);
+	mFileData.resize(size > 0 ? static_cast<size_t>(size) : 0);
+	const size_t read = mFileData.empty() ? 0 : SDL_RWread(file, mFileData.data(), 1, mFileData.size());
+	SDL_RWclose(file);
+
+	if (mFileData.empty() || read != mFileData.size())
 	{
-		TTF_Font* font = TTF_OpenFont(fileName.c_str(), size);
-		if (font == nullptr)
-		{
-			SDL_Log("Failed to load font %s in size %d", fileName.c_str(), size);
-			return false;
-		}
-		mFontData.emplace(size, font);
+		LOG_ERROR(Render, "Failed to read font %s", fileName.c_str());
+		mFileData.clear();
+		return false;
 	}
+
+	mFileName = fileName;
 	return true;
 }
 
+TTF_Font* Font::GetFontData(int pointSize)
+{
+	auto iter = mFontData.find(pointSize);
+	if (iter != mFontData.end())
+	{
+		return iter->second;
+	}
+
+	TTF_Font* font = nullptr;
+	if (!mFileData.empty() && pointSize > 0)
+	{
+		SDL_RWops* rw = SDL_RWFromConstMem(mFileData.data(), static_cast<int>(mFileData.size()));
+		font = TTF_OpenFontRW(rw, 1, pointSize);
+	}
+
+	if (font == nullptr)
+	{
+		LOG_ERROR(Render, "Failed to load font %s in size %d", mFileName.c_str(), pointSize);
+	}
+
+	// Failures are cached too so they are only reported once
+	mFontData.emplace(pointSize, font);
+	return font;
+}
+
 void Font::Unload()
 {
+	mAtlases.clear();
+
 	for (auto& font : mFontData)
 	{
-		TTF_CloseFont(font.second);
+		if (font.second)
+			TTF_CloseFont(font.second);
+	}
+	mFontData.clear();
+	mFileData.clear();
+}
+
+Font::GlyphAtlas::~GlyphAtlas()
+{
+	if (texture)
+	{
+		texture->Unload();
+		delete texture;
 	}
 }
 
@@ -44,18 +157,11 @@ Texture* Font::RenderText(const std::string& text, const Vector3& color /*= Colo
 	Texture* texture = nullptr;
 
 	// Convert to SDL_Color
-	SDL_Color sdlColor;
-	// Swap red and blue so we get RGBA instead of BGRA
-	sdlColor.b = static_cast<Uint8>(color.x * 255);
-	sdlColor.g = static_cast<Uint8>(color.y * 255);
-	sdlColor.r = static_cast<Uint8>(color.z * 255);
-	sdlColor.a = 255;
+	SDL_Color sdlColor = ToSDLColor(color);
 
 	// Find the font data for this point size
-	auto iter = mFontData.find(pointSize);
-	if (iter != mFontData.end())
+	if (TTF_Font* font = GetFontData(pointSize))
 	{
-		TTF_Font* font = iter->second;
 		// Draw this to a surface (blended for alpha)
 		SDL_Surface* surf = TTF_RenderUTF8_Blended_Wrapped(font, text.c_str(), sdlColor, wrapLength);
 		if (surf != nullptr)
@@ -66,10 +172,250 @@ Texture* Font::RenderText(const std::string& text, const Vector3& color /*= Colo
 			SDL_FreeSurface(surf);
 		}
 	}
-	else
+
+	return texture;
+}
+
+Font::GlyphAtlas* Font::GetAtlas(int pointSize, const Vector3& color)
+{
+	const SDL_Color sdlColor = ToSDLColor(color);
+	const uint64_t key = (static_cast<uint64_t>(pointSize) << 32) |
+						 (static_cast<uint64_t>(sdlColor.r) << 16) |
+						 (static_cast<uint64_t>(sdlColor.g) << 8) |
+						 static_cast<uint64_t>(sdlColor.b);
+
+	auto atlasIter = mAtlases.find(key);
+	if (atlasIter != mAtlases.end())
+	{
+		return atlasIter->second.get();
+	}
+
+	TTF_Font* font = GetFontData(pointSize);
+	if (!font)
 	{
-		SDL_Log("Point size %d is unsupported", pointSize);
+		return nullptr;
 	}
 
-	return texture;
+	// Rasterize every glyph once and shelf-pack them into rows
+	SDL_Surface* glyphSurfaces[NUM_GLYPHS] = {};
+	SDL_Rect glyphRects[NUM_GLYPHS] = {};
+	int penX = 0;
+	int penY = 0;
+	int rowHeight = 0;
+	for (int i = 0; i < NUM_GLYPHS; i++)
+	{
+		SDL_Surface* surf = TTF_RenderGlyph_Blended(font, static_cast<Uint16>(FIRST_GLYPH + i), sdlColor);
+		if (!surf)
+			continue;
+
+		if (penX + surf->w > ATLAS_WIDTH)
+		{
+			penX = 0;
+			penY += rowHeight + GLYPH_PADDING;
+			rowHeight = 0;
+		}
+
+		glyphSurfaces[i] = surf;
+		glyphRects[i] = SDL_Rect{penX, penY, surf->w, surf->h};
+		penX += surf->w + GLYPH_PADDING;
+		rowHeight = std::max(rowHeight, surf->h);
+	}
+	// Leave a few empty rows below the ASCII glyphs for codepoints added later
+	const int lineHeight = TTF_FontHeight(font);
+	const int atlasHeight = penY + rowHeight + RESERVED_ROWS * (lineHeight + GLYPH_PADDING);
+
+	SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, std::max(atlasHeight, 1), 32,
+															   SDL_PIXELFORMAT_ABGR8888);
+	if (!atlasSurface)
+	{
+		LOG_ERROR(Render, "Failed to create glyph atlas surface: %s", SDL_GetError());
+		for (auto* surf : glyphSurfaces)
+			SDL_FreeSurface(surf);
+		return nullptr;
+	}
+	SDL_FillRect(atlasSurface, nullptr, SDL_MapRGBA(atlasSurface->format, 0, 0, 0, 0));
+
+	auto atlas = std::make_unique<GlyphAtlas>();
+	atlas->font = font;
+	atlas->color = sdlColor;
+	atlas->lineHeight = static_cast<float>(lineHeight);
+	atlas->width = ATLAS_WIDTH;
+	atlas->height = atlasSurface->h;
+	atlas->penX = penX;
+	atlas->penY = penY;
+	atlas->rowHeight = rowHeight;
+	for (int i = 0; i < NUM_GLYPHS; i++)
+	{
+		if (!glyphSurfaces[i])
+			continue;
+
+		// Copy the glyph's alpha as-is instead of blending it onto the empty atlas
+		SDL_SetSurfaceBlendMode(glyphSurfaces[i], SDL_BLENDMODE_NONE);
+		SDL_Rect dest = glyphRects[i];
+		SDL_BlitSurface(glyphSurfaces[i], nullptr, atlasSurface, &dest);
+		SDL_FreeSurface(glyphSurfaces[i]);
+
+		const SDL_Rect& r = glyphRects[i];
+		atlas->glyphs[i].texRect = Vector4(static_cast<float>(r.x) / ATLAS_WIDTH,
+										   static_cast<float>(r.y) / atlasSurface->h,
+										   static_cast<float>(r.w) / ATLAS_WIDTH,
+										   static_cast<float>(r.h) / atlasSurface->h);
+		atlas->glyphs[i].width = static_cast<float>(r.w);
+		atlas->glyphs[i].height = static_cast<float>(r.h);
+	}
+
+	atlas->texture = new Texture();
+	atlas->texture->CreateFromSurface(atlasSurface);
+	SDL_FreeSurface(atlasSurface);
+
+	GlyphAtlas* result = atlas.get();
+	mAtlases.emplace(key, std::move(atlas));
+	return result;
+}
+
+const Font::Glyph* Font::AddGlyph(GlyphAtlas& atlas, char32_t codepoint)
+{
+	// SDL_ttf rasterizes single glyphs from the Basic Multilingual Plane only
+	if (codepoint > 0xFFFF || !atlas.texture || !TTF_GlyphIsProvided(atlas.font, static_cast<Uint16>(codepoint)))
+		return nullptr;
+
+	SDL_Surface* surf = TTF_RenderGlyph_Blended(atlas.font, static_cast<Uint16>(codepoint), atlas.color);
+	if (!surf)
+		return nullptr;
+
+	int penX = atlas.penX;
+	int penY = atlas.penY;
+	int rowHeight = atlas.rowHeight;
+	if (penX + surf->w > atlas.width)
+	{
+		penX = 0;
+		penY += rowHeight + GLYPH_PADDING;
+		rowHeight = 0;
+	}
+
+	if (surf->w > atlas.width || penY + surf->h > atlas.height)
+	{
+		LOG_WARN(Render, "Glyph atlas for %s is full, drawing U+%04X as '?'", mFileName.c_str(),
+				 static_cast<unsigned>(codepoint));
+		SDL_FreeSurface(surf);
+		return nullptr;
+	}
+
+	// The texture expects the atlas's own pixel layout
+	SDL_Surface* converted = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_ABGR8888, 0);
+	SDL_FreeSurface(surf);
+	if (!converted)
+		return nullptr;
+
+	atlas.texture->UpdateRegion(penX, penY, converted);
+
+	Glyph glyph;
+	glyph.texRect = Vector4(static_cast<float>(penX) / atlas.width,
+							static_cast<float>(penY) / atlas.height,
+							static_cast<float>(converted->w) / atlas.width,
+							static_cast<float>(converted->h) / atlas.height);
+	glyph.width = static_cast<float>(converted->w);
+	glyph.height = static_cast<float>(converted->h);
+	SDL_FreeSurface(converted);
+
+	atlas.penX = penX + static_cast<int>(glyph.width) + GLYPH_PADDING;
+	atlas.penY = penY;
+	atlas.rowHeight = std::max(rowHeight, static_cast<int>(glyph.height));
+
+	return &atlas.extraGlyphs.emplace(codepoint, glyph).first->second;
+}
+
+const Font::Glyph& Font::GetGlyph(GlyphAtlas& atlas, char32_t codepoint)
+{
+	if (codepoint >= FIRST_GLYPH && codepoint < FIRST_GLYPH + NUM_GLYPHS)
+	{
+		return atlas.glyphs[codepoint - FIRST_GLYPH];
+	}
+
+	auto iter = atlas.extraGlyphs.find(codepoint);
+	if (iter != atlas.extraGlyphs.end())
+	{
+		return iter->second;
+	}
+
+	if (const Glyph* glyph = AddGlyph(atlas, codepoint))
+	{
+		return *glyph;
+	}
+
+	// Remember the fallback so a missing glyph is only rasterized once
+	const Glyph& fallback = atlas.glyphs['?' - FIRST_GLYPH];
+	return atlas.extraGlyphs.emplace(codepoint, fallback).first->second;
+}
+
+Vector2 Font::MeasureText(const std::string& text, int pointSize)
+{
+	GlyphAtlas* atlas = GetAtlas(pointSize, Color::White);
+	if (!atlas)
+		return Vector2::Zero;
+
+	float width = 0.0f;
+	float lineWidth = 0.0f;
+	float height = atlas->lineHeight;
+	for (size_t i = 0; i < text.size();)
+	{
+		const char32_t codepoint = NextCodepoint(text, i);
+		if (codepoint == '\n')
+		{
+			width = std::max(width, lineWidth);
+			lineWidth = 0.0f;
+			height += atlas->lineHeight;
+			continue;
+		}
+		lineWidth += GetGlyph(*atlas, codepoint).width;
+	}
+
+	return Vector2(std::max(width, lineWidth), height);
+}
+
+Vector2 Font::DrawText(Renderer* renderer, const std::string& text, const Vector2& topLeft,
+					   const Vector3& color, int pointSize, const Vector2& cameraPos, float maxWidth)
+{
+	GlyphAtlas* atlas = GetAtlas(pointSize, color);
+	if (!atlas || !atlas->texture)
+		return Vector2::Zero;
+
+	size_t first = 0;
+	if (maxWidth > 0.0f && text.find('\n') == std::string::npos)
+	{
+		float lineWidth = 0.0f;
+		for (size_t i = 0; i < text.size();)
+			lineWidth += GetGlyph(*atlas, NextCodepoint(text, i)).width;
+
+		while (first < text.size() && lineWidth > maxWidth)
+			lineWidth -= GetGlyph(*atlas, NextCodepoint(text, first)).width;
+	}
+
+	float x = topLeft.x;
+	float y = topLeft.y;
+	float width = 0.0f;
+	for (size_t i = first; i < text.size();)
+	{
+		const char32_t codepoint = NextCodepoint(text, i);
+		if (codepoint == '\n')
+		{
+			width = std::max(width, x - topLeft.x);
+			x = topLeft.x;
+			y += atlas->lineHeight;
+			continue;
+		}
+
+		const Glyph& glyph = GetGlyph(*atlas, codepoint);
+		if (glyph.width <= 0.0f)
+			continue;
+
+		// Sprites are positioned by their center
+		const Vector2 size(glyph.width, glyph.height);
+		renderer->DrawTexture(Vector2(x + size.x * 0.5f, y + size.y * 0.5f), size, 0.0f, Color::White,
+							  atlas->texture, glyph.texRect, cameraPos);
+		x += glyph.width;
+	}
+
+	width = std::max(width, x - topLeft.x);
+	return Vector2(width, y + atlas->lineHeight - topLeft.y);
 }
@@ -1,6 +1,9 @@
 #pragma once
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <SDL_ttf.h>
 #include "../Math.h"
 
@@ -10,7 +13,8 @@ public:
 	Font();
 	~Font();
 
-	// Load/unload from a file
+	// Load/unload from a file. Point sizes are opened lazily from the
+	// in-memory file the first time they are used.
 	bool Load(const std::string &fileName);
 	void Unload();
 
@@ -18,7 +22,67 @@ public:
 	class Texture *RenderText(const std::string &text, const Vector3 &color = Color::White,
 							  int pointSize = 30, unsigned wrapLength = 900);
 
+	// Draws text as quads from this size/color's glyph atlas, so no texture is
+	// created per call. topLeft is in the same space as cameraPos. If maxWidth > 0
+	// and the line is wider, leading characters are dropped so its end stays visible.
+	// Returns the size of what was drawn.
+	Vector2 DrawText(class Renderer *renderer, const std::string &text, const Vector2 &topLeft,
+					 const Vector3 &color = Color::White, int pointSize = 30,
+					 const Vector2 &cameraPos = Vector2::Zero, float maxWidth = 0.0f);
+
+	// Size DrawText would use for this text
+	Vector2 MeasureText(const std::string &text, int pointSize = 30);
+
 private:
+	// Printable ASCII is rasterized with the atlas; any other codepoint the
+	// font provides is added to the atlas the first time it is drawn
+	static const int FIRST_GLYPH = 32;
+	static const int NUM_GLYPHS = 95;
+	// Rows kept free in each atlas for those late glyphs
+	static const int RESERVED_ROWS = 4;
+
+	struct Glyph
+	{
+		Vector4 texRect;
+		float width;
+		float height;
+	};
+
+	struct GlyphAtlas
+	{
+		~GlyphAtlas();
+
+		class Texture *texture = nullptr;
+		TTF_Font *font = nullptr;
+		SDL_Color color = {};
+		float lineHeight = 0.0f;
+		Glyph glyphs[NUM_GLYPHS] = {};
+		std::unordered_map<char32_t, Glyph> extraGlyphs;
+
+		// Shelf packer state
+		int width = 0;
+		int height = 0;
+		int penX = 0;
+		int penY = 0;
+		int rowHeight = 0;
+	};
+
+	// Opens the point size on first use (null if it can't be opened)
+	TTF_Font *GetFontData(int pointSize);
+
+	// Rasterizes the atlas on first use
+	GlyphAtlas *GetAtlas(int pointSize, const Vector3 &color);
+	// Glyph for a codepoint, rasterizing it into the atlas if needed ('?' if it can't be)
+	const Glyph &GetGlyph(GlyphAtlas &atlas, char32_t codepoint);
+	const Glyph *AddGlyph(GlyphAtlas &atlas, char32_t codepoint);
+
+	// Contents of the TTF file, shared by every point size
+	std::vector<unsigned char> mFileData;
+	std::string mFileName;
+
 	// Map of point sizes to font data
 	std::unordered_map<int, TTF_Font *> mFontData;
+
+	// Glyph atlases keyed by point size and 8-bit color
+	std::unordered_map<uint64_t, std::unique_ptr<GlyphAtlas>> mAtlases;
 };
@@ -0,0 +1,36 @@
+//
+// FontRegistry.cpp
+//
+
+#include "FontRegistry.h"
+#include <SDL_ttf.h>
+#include "Font.h"
+
+std::unordered_map<std::string, std::weak_ptr<Font>>& FontRegistry::GetFonts()
+{
+    static std::unordered_map<std::string, std::weak_ptr<Font>> fonts;
+    return fonts;
+}
+
+std::shared_ptr<Font> FontRegistry::Acquire(const std::string& fileName)
+{
+    if (!TTF_WasInit())
+    {
+        return nullptr;
+    }
+
+    auto& fonts = GetFonts();
+    if (auto font = fonts[fileName].lock())
+    {
+        return font;
+    }
+
+    auto font = std::make_shared<Font>();
+    if (!font->Load(fileName))
+    {
+        return nullptr;
+    }
+
+    fonts[fileName] = font;
+    return font;
+}
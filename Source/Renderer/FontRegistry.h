@@ -0,0 +1,22 @@
+//
+// FontRegistry.h
+//
+
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Process-wide cache of loaded fonts. Everyone asking for the same file shares
+// one Font (and so one copy of the file and one TTF_Font per point size); it
+// is unloaded when the last handle goes away.
+class FontRegistry
+{
+public:
+    // Returns the shared font for fileName, loading it if no handle is alive.
+    // Null if SDL_ttf isn't initialized (headless) or the file can't be read.
+    static std::shared_ptr<class Font> Acquire(const std::string& fileName);
+
+private:
+    static std::unordered_map<std::string, std::weak_ptr<class Font>>& GetFonts();
+};
@@ -0,0 +1,125 @@
+//
+// NullRenderer.cpp
+//
+
+#include "NullRenderer.h"
+#include "Texture.h"
+
+NullRenderer::NullRenderer(Game* game)
+: Renderer(nullptr, game)
+, mPendingSprites(0)
+, mBatchTexture(nullptr)
+, mBatchMode(RendererMode::TRIANGLES)
+{
+}
+
+NullRenderer::~NullRenderer()
+{
+}
+
+bool NullRenderer::Initialize(float width, float height)
+{
+    return true;
+}
+
+void NullRenderer::Shutdown()
+{
+    // Placeholders never own a GL texture, so there is nothing to unload
+    for (auto i : mTextures)
+    {
+        delete i.second;
+    }
+    mTextures.clear();
+}
+
+void NullRenderer::RecordSprite(RendererMode mode, Texture *texture)
+{
+    // Same flush rules as Renderer::AddSprite
+    const Texture *page = texture ? texture->GetPage() : nullptr;
+    const bool textureChanged = page && page != mBatchTexture;
+    const bool stateChanged = textureChanged || mode != mBatchMode;
+    if (stateChanged)
+    {
+        mFrameStats.stateChanges++;
+        Flush();
+    }
+
+    if (page)
+    {
+        mBatchTexture = page;
+    }
+    mBatchMode = mode;
+
+    mPendingSprites++;
+    mFrameStats.sprites++;
+}
+
+void NullRenderer::DrawRect(const Vector2 &position, const Vector2 &size, float rotation, const Vector3 &color,
+                            const Vector2 &cameraPos, RendererMode mode)
+{
+    RecordSprite(mode, nullptr);
+}
+
+void NullRenderer::DrawTexture(const Vector2 &position, const Vector2 &size, float rotation, const Vector3 &color,
+                               Texture *texture, const Vector4 &textureRect, const Vector2 &cameraPos, bool flip,
+                               float textureFactor)
+{
+    RecordSprite(RendererMode::TRIANGLES, texture);
+}
+
+void NullRenderer::DrawGeometry(const Vector2 &position, const Vector2 &size, float rotation, const Vector3 &color,
+                                const Vector2 &cameraPos, VertexArray *vertexArray, RendererMode mode)
+{
+    Flush();
+    mFrameStats.drawCalls++;
+}
+
+void NullRenderer::DrawMesh(const Vector2 &position, const Vector3 &color, const Texture *texture,
+                            VertexArray *vertexArray, const Vector2 &cameraPos)
+{
+    Flush();
+    mFrameStats.drawCalls++;
+}
+
+VertexArray* NullRenderer::CreateVertexArray(const float* verts, unsigned int numVerts,
+                                             const unsigned int* indices, unsigned int numIndices)
+{
+    return nullptr;
+}
+
+void NullRenderer::Clear()
+{
+    mFrameStats = RenderStats();
+}
+
+void NullRenderer::Flush()
+{
+    if (mPendingSprites > 0)
+    {
+        mFrameStats.flushes++;
+        mFrameStats.drawCalls++;
+        mPendingSprites = 0;
+    }
+
+    mBatchTexture = nullptr;
+}
+
+void NullRenderer::Present()
+{
+    Flush();
+    mLastFrameStats = mFrameStats;
+}
+
+Texture* NullRenderer::GetTexture(const std::string& fileName)
+{
+    auto iter = mTextures.find(fileName);
+    if (iter != mTextures.end())
+    {
+        return iter->second;
+    }
+
+    auto* tex = new Texture();
+    tex->SetAtlasRegion(&mPlaceholderPage, Vector4::UnitRect, 0, 0);
+    mTextures.emplace(fileName, tex);
+    return tex;
+}
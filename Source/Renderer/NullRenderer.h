@@ -0,0 +1,55 @@
+//
+// NullRenderer.h
+//
+
+#pragma once
+#include "Renderer.h"
+
+// Renderer backend for headless runs: creates no window or GL context and
+// only records what the real sprite batch would have submitted
+class NullRenderer : public Renderer
+{
+public:
+	explicit NullRenderer(Game* game);
+	~NullRenderer() override;
+
+	bool Initialize(float width, float height) override;
+	void Shutdown() override;
+
+    void DrawRect(const Vector2 &position, const Vector2 &size,  float rotation,
+                  const Vector3 &color, const Vector2 &cameraPos, RendererMode mode) override;
+
+    void DrawTexture(const Vector2 &position, const Vector2 &size,  float rotation,
+                     const Vector3 &color, Texture *texture,
+                     const Vector4 &textureRect = Vector4::UnitRect,
+                     const Vector2 &cameraPos = Vector2::Zero, bool flip = false,
+                     float textureFactor = 1.0f) override;
+
+    void DrawGeometry(const Vector2 &position, const Vector2 &size,  float rotation,
+                      const Vector3 &color, const Vector2 &cameraPos, VertexArray *vertexArray, RendererMode mode) override;
+
+    void DrawMesh(const Vector2 &position, const Vector3 &color, const Texture *texture,
+                  VertexArray *vertexArray, const Vector2 &cameraPos) override;
+
+    // No GL context to upload to; callers still draw with the null array
+    VertexArray* CreateVertexArray(const float* verts, unsigned int numVerts,
+                                   const unsigned int* indices, unsigned int numIndices) override;
+
+    void Clear() override;
+    void Present() override;
+    void Flush() override;
+
+    // Returns an empty placeholder (no image is decoded); all of them share one
+    // page so batching matches the packed sprites of the real renderer
+    class Texture* GetTexture(const std::string& fileName) override;
+
+private:
+    void RecordSprite(RendererMode mode, Texture *texture);
+
+    int mPendingSprites;
+    const Texture* mBatchTexture;
+
+    // Stands in for the atlas page the real renderer packs sprites into
+    Texture mPlaceholderPage;
+    RendererMode mBatchMode;
+};
@@ -3,14 +3,39 @@
 #include "Shader.h"
 #include "VertexArray.h"
 #include "Texture.h"
+#include "SpriteBatch.h"
 #include "../Game.h"
+#include "../Utils/Profiler.h"
+#include "../Utils/Log.h"
+#include <cstring>
+
+namespace
+{
+    // CPU mirror of the FrameData uniform block (std140 layout)
+    struct FrameData
+    {
+        float orthoProj[16];
+        float fade;
+        float padding[3];
+    };
+}
 
 Renderer::Renderer(SDL_Window *window, Game* game)
-: mBaseShader(nullptr)
+: mGame(game)
+, mBaseShader(nullptr)
+, mSpriteShader(nullptr)
+, mSpriteVerts(nullptr)
+, mSpriteBatch(nullptr)
+, mBatchTexture(nullptr)
+, mBatchMode(RendererMode::TRIANGLES)
+, mTextureLoader(nullptr)
+, mPlaceholderTexture(nullptr)
+, mLoadingTextures(false)
 , mWindow(window)
 , mContext(nullptr)
+, mHasVSync(false)
 , mOrthoProjection(Matrix4::Identity)
-, mGame(game)
+, mFrameDataBuffer(0)
 {
 
 }
@@ -19,6 +44,9 @@ Renderer::~Renderer()
 {
     delete mSpriteVerts;
     mSpriteVerts = nullptr;
+
+    delete mSpriteBatch;
+    mSpriteBatch = nullptr;
 }
 
 bool Renderer::Initialize(float width, float height)
@@ -34,28 +62,44 @@ bool Renderer::Initialize(float width, float height)
     // Force OpenGL to use hardware acceleration
     SDL_GL_SetAttribute(SDL_GL_ACCELERATED_VISUAL, 1);
 
-    // Turn on vsync
-    SDL_GL_SetSwapInterval(1);
-
     // Create an OpenGL context
     mContext = SDL_GL_CreateContext(mWindow);
 
+    // Turn on vsync (needs a current context) to pace rendering; without it
+    // the game loop sleeps off the rest of each frame instead
+    mHasVSync = SDL_GL_SetSwapInterval(1) == 0;
+    if (!mHasVSync)
+    {
+        LOG_WARN(Render, "VSync unavailable (%s), capping the frame rate with sleeps", SDL_GetError());
+    }
+
     // Initialize GLEW
     glewExperimental = GL_TRUE;
     if (glewInit() != GLEW_OK) {
-        SDL_Log("Failed to initialize GLEW.");
+        LOG_ERROR(Render, "Failed to initialize GLEW.");
         return false;
     }
 
 	// Make sure we can create/compile shaders
 	if (!LoadShaders()) {
-		SDL_Log("Failed to load shaders.");
+		LOG_ERROR(Render, "Failed to load shaders.");
 		return false;
 	}
 
     // Create quad for drawing sprites
     CreateSpriteVerts();
 
+    // Create streaming buffer for batched sprites
+    mSpriteBatch = new SpriteBatch();
+
+    // Single transparent pixel drawn in place of textures still loading
+    SDL_Surface* blank = SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 32, SDL_PIXELFORMAT_ABGR8888);
+    mPlaceholderTexture = new Texture();
+    mPlaceholderTexture->Load(blank);
+    SDL_FreeSurface(blank);
+
+    mTextureLoader = new TextureLoader();
+
     // Set the clear color to black
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
@@ -65,18 +109,32 @@ bool Renderer::Initialize(float width, float height)
 
     // Create orthografic projection matrix
     mOrthoProjection = Matrix4::CreateOrtho(0.0f, width, height, 0.0f, -1.0f, 1.0f);
-    mBaseShader->SetMatrixUniform("uOrthoProj", mOrthoProjection);
 
-    mBaseShader->SetIntegerUniform("uTexture", 0);
+    // Per-frame constants shared by both shaders
+    glGenBuffers(1, &mFrameDataBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, mFrameDataBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_DATA_BINDING, mFrameDataBuffer);
+    mSpriteShader->BindUniformBlock("FrameData", FRAME_DATA_BINDING);
+    mBaseShader->BindUniformBlock("FrameData", FRAME_DATA_BINDING);
+    UpdateFrameData();
+
+    mSpriteShader->SetActive();
+    mSpriteShader->SetIntegerUniform("uTexture", 0);
 
-    // Activate shader
     mBaseShader->SetActive();
+    mBaseShader->SetIntegerUniform("uTexture", 0);
 
     return true;
 }
 
 void Renderer::Shutdown()
 {
+    // Workers may still be decoding into textures destroyed below
+    delete mTextureLoader;
+    mTextureLoader = nullptr;
+
     // Destroy textures
     for (auto i : mTextures)
     {
@@ -84,10 +142,21 @@ void Renderer::Shutdown()
         delete i.second;
     }
     mTextures.clear();
+    mAtlas.Unload();
+
+    mPlaceholderTexture->Unload();
+    delete mPlaceholderTexture;
+    mPlaceholderTexture = nullptr;
 
     mBaseShader->Unload();
     delete mBaseShader;
 
+    mSpriteShader->Unload();
+    delete mSpriteShader;
+
+    glDeleteBuffers(1, &mFrameDataBuffer);
+    mFrameDataBuffer = 0;
+
     SDL_GL_DeleteContext(mContext);
 	SDL_DestroyWindow(mWindow);
 }
@@ -96,16 +165,161 @@ void Renderer::Clear()
 {
     // Clear the color buffer
     glClear(GL_COLOR_BUFFER_BIT);
+
+    UpdateFrameData();
+    UploadPendingTextures();
+
+    mFrameStats = RenderStats();
+}
+
+void Renderer::UploadPendingTextures()
+{
+    PROFILE_SCOPE("Renderer::UploadPendingTextures");
+
+    std::vector<TextureLoader::Result> results;
+    mLoadingTextures = mTextureLoader->Collect(results, UPLOAD_BYTES_PER_FRAME);
+
+    for (auto& result : results)
+    {
+        // Failed loads keep drawing the placeholder
+        if (!result.surface)
+            continue;
+
+        if (!mAtlas.Add(result.surface, result.texture))
+        {
+            result.texture->Load(result.surface);
+        }
+        SDL_FreeSurface(result.surface);
+    }
+}
+
+void Renderer::UpdateFrameData()
+{
+    FrameData data{};
+    std::memcpy(data.orthoProj, mOrthoProjection.GetAsFloatPtr(), sizeof(data.orthoProj));
+    data.fade = mGame->mFadeValue;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, mFrameDataBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameData), &data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void Renderer::Flush()
+{
+    PROFILE_SCOPE("Renderer::Flush");
+
+    if (mSpriteBatch->IsEmpty())
+        return;
+
+    mSpriteShader->SetActive();
+
+    if (mBatchTexture)
+    {
+        mBatchTexture->SetActive();
+    }
+
+    if (mSpriteBatch->Flush(mBatchMode))
+    {
+        mFrameStats.flushes++;
+        mFrameStats.drawCalls++;
+    }
+
+    // The texture may be destroyed by its owner right after this
+    mBatchTexture = nullptr;
+}
+
+void Renderer::AddSprite(RendererMode mode, const Vector2 &position, const Vector2 &size, float rotation,
+                         const Vector3 &color, Texture *texture, const Vector4 &textureRect,
+                         const Vector2 &cameraPos, float textureFactor)
+{
+    const unsigned int numVerts = mode == RendererMode::LINES ? 8 : 4;
+
+    // Untextured sprites ignore the sampler, so they can join any texture's batch;
+    // textures packed into the same atlas page share a batch too
+    const Texture *page = texture ? texture->GetPage() : nullptr;
+    const bool textureChanged = page && page != mBatchTexture;
+    const bool stateChanged = textureChanged || mode != mBatchMode;
+    if (stateChanged)
+    {
+        mFrameStats.stateChanges++;
+    }
+
+    if (!mSpriteBatch->IsEmpty() && (stateChanged || !mSpriteBatch->HasRoom(numVerts)))
+    {
+        Flush();
+    }
+
+    if (page)
+    {
+        mBatchTexture = page;
+    }
+    mBatchMode = mode;
+
+    Vector4 pageRect = textureRect;
+    if (texture)
+    {
+        pageRect = texture->MapRect(textureRect);
+    }
+    else
+    {
+        textureFactor = 0.0f;
+    }
+
+    const float cosTheta = rotation != 0.0f ? Math::Cos(rotation) : 1.0f;
+    const float sinTheta = rotation != 0.0f ? Math::Sin(rotation) : 0.0f;
+
+    // Same corners/UVs as the sprite quad (top-right, top-left, bottom-right, bottom-left)
+    const float corners[4][4] = {
+        { 0.5f,  0.5f, 1.0f, 1.0f},
+        {-0.5f,  0.5f, 0.0f, 1.0f},
+        { 0.5f, -0.5f, 1.0f, 0.0f},
+        {-0.5f, -0.5f, 0.0f, 0.0f}
+    };
+
+    SpriteVertex quad[4];
+    for (int i = 0; i < 4; i++)
+    {
+        const float localX = corners[i][0] * size.x;
+        const float localY = corners[i][1] * size.y;
+
+        SpriteVertex &vertex = quad[i];
+        vertex.x = localX * cosTheta - localY * sinTheta + position.x - cameraPos.x;
+        vertex.y = localX * sinTheta + localY * cosTheta + position.y - cameraPos.y;
+        vertex.u = corners[i][2] * pageRect.z + pageRect.x;
+        vertex.v = corners[i][3] * pageRect.w + pageRect.y;
+        vertex.r = color.x;
+        vertex.g = color.y;
+        vertex.b = color.z;
+        vertex.textureFactor = textureFactor;
+    }
+
+    if (mode == RendererMode::LINES)
+    {
+        // Outline as independent segments: TR-TL, TL-BL, BL-BR, BR-TR
+        const SpriteVertex lines[8] = {quad[0], quad[1], quad[1], quad[3], quad[3], quad[2], quad[2], quad[0]};
+        mSpriteBatch->Append(lines, 8);
+    }
+    else
+    {
+        mSpriteBatch->Append(quad, 4);
+    }
+
+    mFrameStats.sprites++;
 }
 
 void Renderer::Draw(RendererMode mode, const Matrix4 &modelMatrix, const Vector2 &cameraPos, VertexArray *vertices,
-                    const Vector3 &color, Texture *texture, const Vector4 &textureRect, float textureFactor)
+                    const Vector3 &color, const Texture *texture, const Vector4 &textureRect, float textureFactor)
 {
+    PROFILE_SCOPE("Renderer::Draw");
+
+    // Keep ordering with anything already batched
+    Flush();
+    mBaseShader->SetActive();
+
     mBaseShader->SetMatrixUniform("uWorldTransform", modelMatrix);
     mBaseShader->SetVectorUniform("uColor", color);
-    mBaseShader->SetVectorUniform("uTexRect", textureRect);
+    mBaseShader->SetVectorUniform("uTexRect", texture ? texture->MapRect(textureRect) : textureRect);
     mBaseShader->SetVectorUniform("uCameraPos", cameraPos);
-    glUniform1f(glGetUniformLocation(mBaseShader->GetProgram(), "fade"), mGame->mFadeValue);
 
     if(vertices)
     {
@@ -129,16 +343,14 @@ void Renderer::Draw(RendererMode mode, const Matrix4 &modelMatrix, const Vector2
     {
         glDrawElements(GL_TRIANGLES, vertices->GetNumIndices(), GL_UNSIGNED_INT,nullptr);
     }
+
+    mFrameStats.drawCalls++;
 }
 
 void Renderer::DrawRect(const Vector2 &position, const Vector2 &size, float rotation, const Vector3 &color,
                         const Vector2 &cameraPos, RendererMode mode)
 {
-    Matrix4 model = Matrix4::CreateScale(Vector3(size.x, size.y, 1.0f)) *
-                    Matrix4::CreateRotationZ(rotation) *
-                    Matrix4::CreateTranslation(Vector3(position.x, position.y, 0.0f));
-
-    Draw(mode, model, cameraPos, mSpriteVerts, color);
+    AddSprite(mode, position, size, rotation, color, nullptr, Vector4::UnitRect, cameraPos, 0.0f);
 }
 
 void Renderer::DrawTexture(const Vector2 &position, const Vector2 &size, float rotation, const Vector3 &color,
@@ -147,11 +359,8 @@ void Renderer::DrawTexture(const Vector2 &position, const Vector2 &size, float r
 {
     float flipFactor = flip ? -1.0f : 1.0f;
 
-    Matrix4 model = Matrix4::CreateScale(Vector3(size.x * flipFactor, size.y, 1.0f)) *
-                    Matrix4::CreateRotationZ(rotation) *
-                    Matrix4::CreateTranslation(Vector3(position.x, position.y, 0.0f));
-
-    Draw(RendererMode::TRIANGLES, model, cameraPos, mSpriteVerts, color, texture, textureRect, textureFactor);
+    AddSprite(RendererMode::TRIANGLES, position, Vector2(size.x * flipFactor, size.y), rotation, color,
+              texture, textureRect, cameraPos, textureFactor);
 }
 
 void Renderer::DrawGeometry(const Vector2 &position, const Vector2 &size, float rotation, const Vector3 &color,
@@ -164,8 +373,29 @@ void Renderer::DrawGeometry(const Vector2 &position, const Vector2 &size, float
     Draw(mode, model, cameraPos, vertexArray, color);
 }
 
+void Renderer::DrawMesh(const Vector2 &position, const Vector3 &color, const Texture *texture,
+                        VertexArray *vertexArray, const Vector2 &cameraPos)
+{
+    if (!vertexArray)
+        return;
+
+    Matrix4 model = Matrix4::CreateTranslation(Vector3(position.x, position.y, 0.0f));
+    Draw(RendererMode::TRIANGLES, model, cameraPos, vertexArray, color, texture);
+}
+
+VertexArray* Renderer::CreateVertexArray(const float* verts, unsigned int numVerts,
+                                         const unsigned int* indices, unsigned int numIndices)
+{
+    return new VertexArray(verts, numVerts, indices, numIndices);
+}
+
 void Renderer::Present()
 {
+    PROFILE_SCOPE("Renderer::Present");
+
+    Flush();
+    mLastFrameStats = mFrameStats;
+
 	// Swap the buffers
 	SDL_GL_SwapWindow(mWindow);
 }
@@ -178,6 +408,11 @@ bool Renderer::LoadShaders()
 		return false;
 	}
 
+	mSpriteShader = new Shader();
+	if (!mSpriteShader->Load("../Shaders/Sprite")) {
+		return false;
+	}
+
 	mBaseShader->SetActive();
 
     return true;
@@ -213,16 +448,11 @@ Texture* Renderer::GetTexture(const std::string& fileName)
     else
     {
         tex = new Texture();
-        if (tex->Load(fileName))
-        {
-            mTextures.emplace(fileName, tex);
-            return tex;
-        }
-        else
-        {
-            delete tex;
-            return nullptr;
-        }
+        tex->SetPending(mPlaceholderTexture);
+        mTextures.emplace(fileName, tex);
+
+        mTextureLoader->Request(tex, fileName);
+        mLoadingTextures = true;
     }
     return tex;
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "../Math.h"
 #include "VertexArray.h"
 #include "Texture.h"
+#include "TextureAtlas.h"
+#include "TextureLoader.h"
 
 class Game;
 
@@ -15,37 +17,72 @@ enum class RendererMode
     LINES
 };
 
+// Per-frame counters for the sprite batch
+struct RenderStats
+{
+    int sprites = 0;
+    int flushes = 0;
+    int drawCalls = 0;
+    int stateChanges = 0;
+};
+
 class Renderer
 {
 public:
 	Renderer(SDL_Window* window, Game* game);
-	~Renderer();
+	virtual ~Renderer();
 
-	bool Initialize(float width, float height);
-	void Shutdown();
+	virtual bool Initialize(float width, float height);
+	virtual void Shutdown();
 
-    void DrawRect(const Vector2 &position, const Vector2 &size,  float rotation,
+    virtual void DrawRect(const Vector2 &position, const Vector2 &size,  float rotation,
                   const Vector3 &color, const Vector2 &cameraPos, RendererMode mode);
 
-    void DrawTexture(const Vector2 &position, const Vector2 &size,  float rotation,
+    // textureRect is normalized to the texture; it's remapped if the texture lives in an atlas page
+    virtual void DrawTexture(const Vector2 &position, const Vector2 &size,  float rotation,
                      const Vector3 &color, Texture *texture,
                      const Vector4 &textureRect = Vector4::UnitRect,
                      const Vector2 &cameraPos = Vector2::Zero, bool flip = false,
                      float textureFactor = 1.0f);
 
-    void DrawGeometry(const Vector2 &position, const Vector2 &size,  float rotation,
+    virtual void DrawGeometry(const Vector2 &position, const Vector2 &size,  float rotation,
                       const Vector3 &color, const Vector2 &cameraPos, VertexArray *vertexArray, RendererMode mode);
 
-    void Clear();
-    void Present();
+    // Draws a textured triangle mesh whose vertices are already laid out relative to position
+    virtual void DrawMesh(const Vector2 &position, const Vector3 &color, const Texture *texture,
+                          VertexArray *vertexArray, const Vector2 &cameraPos);
+
+    // GPU buffers for a static mesh (null when there is no GL context)
+    virtual VertexArray* CreateVertexArray(const float* verts, unsigned int numVerts,
+                                           const unsigned int* indices, unsigned int numIndices);
+
+    virtual void Clear();
+    virtual void Present();
+
+    // Submits every pending sprite (must be called before destroying a texture drawn this frame)
+    virtual void Flush();
 
     // Getters
-    class Texture* GetTexture(const std::string& fileName);
+    // Images are decoded in the background; until uploaded the texture draws as a
+    // transparent placeholder, so the returned pointer can be kept and used right away
+    virtual class Texture* GetTexture(const std::string& fileName);
+
+    // Whether some requested texture is still being decoded or waiting for upload
+    bool IsLoadingTextures() const { return mLoadingTextures; }
+    // Whether Present blocks on the display's refresh (swap interval accepted)
+    bool HasVSync() const { return mHasVSync; }
 	class Shader* GetBaseShader() const { return mBaseShader; }
 
+    // Counters of the last presented frame
+    const RenderStats& GetFrameStats() const { return mLastFrameStats; }
+
 private:
+    void AddSprite(RendererMode mode, const Vector2 &position, const Vector2 &size, float rotation,
+                   const Vector3 &color, Texture *texture, const Vector4 &textureRect,
+                   const Vector2 &cameraPos, float textureFactor);
+
     void Draw(RendererMode mode, const Matrix4 &modelMatrix, const Vector2 &cameraPos, VertexArray *vertices,
-              const Vector3 &color,  Texture *texture = nullptr, const Vector4 &textureRect = Vector4::UnitRect, float textureFactor = 1.0f);
+              const Vector3 &color, const Texture *texture = nullptr, const Vector4 &textureRect = Vector4::UnitRect, float textureFactor = 1.0f);
 
 	bool LoadShaders();
     void CreateSpriteVerts();
@@ -56,18 +93,48 @@ private:
 	// Basic shader
 	class Shader* mBaseShader;
 
+    // Shader for batched, pre-transformed sprites
+    class Shader* mSpriteShader;
+
     // Sprite vertex array
     class VertexArray *mSpriteVerts;
 
+    // Pending sprites and the state they were recorded with
+    class SpriteBatch* mSpriteBatch;
+    const Texture* mBatchTexture;
+    RendererMode mBatchMode;
+
+protected:
+    RenderStats mFrameStats;
+    RenderStats mLastFrameStats;
+
+    // Map of textures loaded
+    std::unordered_map<std::string, class Texture*> mTextures;
+
+    // Pages small textures are packed into, so most sprites share one bound texture
+    TextureAtlas mAtlas;
+
+    // Background image decoding; finished images are uploaded at the start of a
+    // frame, up to UPLOAD_BYTES_PER_FRAME of pixels per frame
+    static const size_t UPLOAD_BYTES_PER_FRAME = 4 * 1024 * 1024;
+    TextureLoader* mTextureLoader;
+    Texture* mPlaceholderTexture;
+    bool mLoadingTextures;
+    void UploadPendingTextures();
+
 	// Window
 	SDL_Window* mWindow;
 
 	// OpenGL context
 	SDL_GLContext mContext;
+    bool mHasVSync;
 
 	// Ortho projection for 2D shaders
 	Matrix4 mOrthoProjection;
 
-    // Map of textures loaded
-    std::unordered_map<std::string, class Texture*> mTextures;
+    // Uniform buffer behind the shaders' FrameData block (projection and fade),
+    // uploaded once per frame in Clear
+    static const unsigned int FRAME_DATA_BINDING = 0;
+    unsigned int mFrameDataBuffer;
+    void UpdateFrameData();
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <SDL.h>
 #include "Shader.h"
+#include "../Utils/Log.h"
 #include <fstream>
 #include <sstream>
 
@@ -31,7 +32,52 @@ bool Shader::Load(const std::string& name)
 	glLinkProgram(mShaderProgram);
 
 	// Verify that the program linked successfully
-	return IsValidProgram();
+	if (!IsValidProgram())
+	{
+		return false;
+	}
+
+	CacheUniformLocations();
+	return true;
+}
+
+void Shader::CacheUniformLocations()
+{
+	mUniformLocations.clear();
+
+	GLint numUniforms = 0;
+	glGetProgramiv(mShaderProgram, GL_ACTIVE_UNIFORMS, &numUniforms);
+
+	char name[256];
+	for (GLint i = 0; i < numUniforms; i++)
+	{
+		GLsizei length = 0;
+		GLint size = 0;
+		GLenum type = 0;
+		glGetActiveUniform(mShaderProgram, static_cast<GLuint>(i), sizeof(name), &length, &size, &type, name);
+
+		// Members of uniform blocks have no location of their own
+		const GLint loc = glGetUniformLocation(mShaderProgram, name);
+		if (loc != -1)
+		{
+			mUniformLocations.emplace(std::string(name, length), loc);
+		}
+	}
+}
+
+GLint Shader::GetUniformLocation(const char* name) const
+{
+	auto iter = mUniformLocations.find(name);
+	return iter != mUniformLocations.end() ? iter->second : -1;
+}
+
+void Shader::BindUniformBlock(const char* blockName, GLuint bindingPoint) const
+{
+	const GLuint blockIndex = glGetUniformBlockIndex(mShaderProgram, blockName);
+	if (blockIndex != GL_INVALID_INDEX)
+	{
+		glUniformBlockBinding(mShaderProgram, blockIndex, bindingPoint);
+	}
 }
 
 void Shader::Unload()
@@ -44,6 +90,7 @@ void Shader::Unload()
 	mShaderProgram = 0;
 	mVertexShader = 0;
 	mFragShader = 0;
+	mUniformLocations.clear();
 }
 
 void Shader::SetActive() const
@@ -54,8 +101,8 @@ void Shader::SetActive() const
 
 void Shader::SetVectorUniform(const char* name, const Vector2& vector) const
 {
-    // Find the uniform by this name
-    GLint loc = glGetUniformLocation(mShaderProgram, name);
+    // Look up the cached location
+    GLint loc = GetUniformLocation(name);
 
     // Send the vector data to the uniform
     glUniform2fv(loc, 1, vector.GetAsFloatPtr());
@@ -63,8 +110,8 @@ void Shader::SetVectorUniform(const char* name, const Vector2& vector) const
 
 void Shader::SetVectorUniform(const char* name, const Vector3& vector) const
 {
-	// Find the uniform by this name
-	GLint loc = glGetUniformLocation(mShaderProgram, name);
+	// Look up the cached location
+	GLint loc = GetUniformLocation(name);
 
 	// Send the vector data to the uniform
 	glUniform3fv(loc, 1, vector.GetAsFloatPtr());
@@ -72,8 +119,8 @@ void Shader::SetVectorUniform(const char* name, const Vector3& vector) const
 
 void Shader::SetVectorUniform(const char* name, const Vector4& vector) const
 {
-    // Find the uniform by this name
-    GLint loc = glGetUniformLocation(mShaderProgram, name);
+    // Look up the cached location
+    GLint loc = GetUniformLocation(name);
 
     // Send the vector data to the uniform
     glUniform4fv(loc, 1, vector.GetAsFloatPtr());
@@ -81,8 +128,8 @@ void Shader::SetVectorUniform(const char* name, const Vector4& vector) const
 
 void Shader::SetMatrixUniform(const char* name, const Matrix4& matrix) const
 {
-	// Find the uniform by this name
-	GLuint loc = glGetUniformLocation(mShaderProgram, name);
+	// Look up the cached location
+	GLint loc = GetUniformLocation(name);
 
     // Send the matrix data to the uniform
 	glUniformMatrix4fv(loc, 1, GL_FALSE, matrix.GetAsFloatPtr());
@@ -90,8 +137,8 @@ void Shader::SetMatrixUniform(const char* name, const Matrix4& matrix) const
 
 void Shader::SetFloatUniform(const char *name, float value) const
 {
-    // Find the uniform by this name
-    GLuint loc = glGetUniformLocation(mShaderProgram, name);
+    // Look up the cached location
+    GLint loc = GetUniformLocation(name);
 
     // Send the float data to the uniform
     glUniform1f(loc, value);
@@ -99,9 +146,9 @@ void Shader::SetFloatUniform(const char *name, float value) const
 
 void Shader::SetIntegerUniform(const char *name, int value) const
 {
-	GLint uTexture = glGetUniformLocation(mShaderProgram, name);
+	GLint uTexture = GetUniformLocation(name);
 	if (uTexture == -1) {
-		SDL_Log("Warning: Uniform '%s' not found in shader!", name);
+		LOG_WARN(Render, "Uniform '%s' not found in shader!", name);
 		return;
 	}
 	glUniform1i(uTexture, value);
@@ -128,13 +175,13 @@ bool Shader::CompileShader(const std::string& fileName, GLenum shaderType, GLuin
 
 		if (!IsCompiled(outShader))
 		{
-			SDL_Log("Failed to compile shader %s", fileName.c_str());
+			LOG_ERROR(Render, "Failed to compile shader %s", fileName.c_str());
 			return false;
 		}
 	}
 	else
 	{
-		SDL_Log("Shader file not found: %s", fileName.c_str());
+		LOG_ERROR(Render, "Shader file not found: %s", fileName.c_str());
 		return false;
 	}
 
@@ -153,7 +200,7 @@ bool Shader::IsCompiled(GLuint shader)
 		char buffer[512];
 		memset(buffer, 0, 512);
 		glGetShaderInfoLog(shader, 511, nullptr, buffer);
-		SDL_Log("GLSL Compile Failed:\n%s", buffer);
+		LOG_ERROR(Render, "GLSL Compile Failed:\n%s", buffer);
 		return false;
 	}
 
@@ -171,7 +218,7 @@ bool Shader::IsValidProgram() const
 		char buffer[512];
 		memset(buffer, 0, 512);
 		glGetProgramInfoLog(mShaderProgram, 511, nullptr, buffer);
-		SDL_Log("GLSL Link Status:\n%s", buffer);
+		LOG_ERROR(Render, "GLSL Link Status:\n%s", buffer);
 		return false;
 	}
 
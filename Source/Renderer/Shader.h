@@ -1,6 +1,7 @@
 #pragma once
 #include <GL/glew.h>
 #include <string>
+#include <unordered_map>
 #include "../Math.h"
 
 class Shader
@@ -25,6 +26,12 @@ public:
     void SetFloatUniform(const char* name, float value) const;
     void SetIntegerUniform(const char *name, int value) const;
 
+    // Location cached at link time (-1 if the uniform isn't active)
+    GLint GetUniformLocation(const char* name) const;
+
+    // Connects a uniform block of this program to a buffer binding point
+    void BindUniformBlock(const char* blockName, GLuint bindingPoint) const;
+
 	[[nodiscard]] GLuint GetProgram() const { return mShaderProgram; }
 
 private:
@@ -35,9 +42,13 @@ private:
 	bool IsCompiled(GLuint shader);
 	// Tests whether vertex/fragment programs link
 	bool IsValidProgram() const;
+	// Queries every active uniform's location once after linking
+	void CacheUniformLocations();
 
 	// Store the shader object IDs
 	GLuint mVertexShader;
 	GLuint mFragShader;
 	GLuint mShaderProgram;
+
+	std::unordered_map<std::string, GLint> mUniformLocations;
 };
@@ -0,0 +1,92 @@
+//
+// SpriteBatch.cpp
+//
+
+#include "SpriteBatch.h"
+#include <cstddef>
+#include <GL/glew.h>
+
+SpriteBatch::SpriteBatch(const unsigned int maxQuads)
+: mMaxVerts(maxQuads * 4)
+, mVertexBuffer(0)
+, mIndexBuffer(0)
+, mVertexArray(0)
+{
+	mVertices.reserve(mMaxVerts);
+
+	// Every quad uses the same winding as the old sprite quad
+	std::vector<unsigned int> indices;
+	indices.reserve(maxQuads * 6);
+	for (unsigned int i = 0; i < maxQuads; i++)
+	{
+		const unsigned int base = i * 4;
+		indices.insert(indices.end(), {base, base + 1, base + 2, base + 1, base + 3, base + 2});
+	}
+
+	glGenVertexArrays(1, &mVertexArray);
+	glBindVertexArray(mVertexArray);
+
+	glGenBuffers(1, &mVertexBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, mMaxVerts * sizeof(SpriteVertex), nullptr, GL_STREAM_DRAW);
+
+	glGenBuffers(1, &mIndexBuffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+	// Position
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, x));
+
+	// Texture coordinate
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, u));
+
+	// Color
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, r));
+
+	// Texture factor
+	glEnableVertexAttribArray(3);
+	glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, textureFactor));
+
+	glBindVertexArray(0);
+}
+
+SpriteBatch::~SpriteBatch()
+{
+	glDeleteBuffers(1, &mVertexBuffer);
+	glDeleteBuffers(1, &mIndexBuffer);
+	glDeleteVertexArrays(1, &mVertexArray);
+}
+
+void SpriteBatch::Append(const SpriteVertex* vertices, const unsigned int count)
+{
+	mVertices.insert(mVertices.end(), vertices, vertices + count);
+}
+
+bool SpriteBatch::Flush(const RendererMode mode)
+{
+	if (mVertices.empty())
+		return false;
+
+	glBindVertexArray(mVertexArray);
+	glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+
+	// Orphan the previous storage so the driver doesn't stall on in-flight draws
+	glBufferData(GL_ARRAY_BUFFER, mMaxVerts * sizeof(SpriteVertex), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, mVertices.size() * sizeof(SpriteVertex), mVertices.data());
+
+	const auto numVerts = static_cast<GLsizei>(mVertices.size());
+	if (mode == RendererMode::LINES)
+	{
+		glDrawArrays(GL_LINES, 0, numVerts);
+	}
+	else
+	{
+		glDrawElements(GL_TRIANGLES, (numVerts / 4) * 6, GL_UNSIGNED_INT, nullptr);
+	}
+
+	mVertices.clear();
+	return true;
+}
@@ -0,0 +1,44 @@
+//
+// SpriteBatch.h
+//
+
+#pragma once
+#include <vector>
+#include "Renderer.h"
+
+// Vertex already transformed to view space, so a whole batch can be
+// drawn with a single call no matter how many sprites it holds
+struct SpriteVertex
+{
+	float x, y;
+	float u, v;
+	float r, g, b;
+	float textureFactor;
+};
+
+// Streaming vertex buffer that accumulates sprites sharing the same
+// texture/mode and submits them together on Flush
+class SpriteBatch
+{
+public:
+	explicit SpriteBatch(unsigned int maxQuads = 4096);
+	~SpriteBatch();
+
+	// Whether count more vertices fit before a flush is required
+	bool HasRoom(unsigned int count) const { return mVertices.size() + count <= mMaxVerts; }
+	bool IsEmpty() const { return mVertices.empty(); }
+
+	void Append(const SpriteVertex* vertices, unsigned int count);
+
+	// Uploads pending vertices and issues one draw call; returns false if empty
+	bool Flush(RendererMode mode);
+
+private:
+	unsigned int mMaxVerts;
+
+	std::vector<SpriteVertex> mVertices;
+
+	unsigned int mVertexBuffer;
+	unsigned int mIndexBuffer;
+	unsigned int mVertexArray;
+};
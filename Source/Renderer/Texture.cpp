@@ -1,9 +1,13 @@
 #include "Texture.h"
+#include "../Utils/Log.h"
 
 Texture::Texture()
 : mTextureID(0)
 , mWidth(0)
 , mHeight(0)
+, mPage(nullptr)
+, mAtlasRect(Vector4::UnitRect)
+, mIsPending(false)
 {
 }
 
@@ -11,21 +15,42 @@ Texture::~Texture()
 {
 }
 
-bool Texture::Load(const std::string &filePath)
+SDL_Surface* Texture::LoadSurface(const std::string &filePath)
 {
     SDL_Surface* loaded = IMG_Load(filePath.c_str());
     if (!loaded) {
-        SDL_Log("Failed to load texture: %s, SDL_image Error: %s", filePath.c_str(), IMG_GetError());
-        return false;
+        LOG_ERROR(Render, "Failed to load texture: %s, SDL_image Error: %s", filePath.c_str(), IMG_GetError());
+        return nullptr;
     }
 
     SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ABGR8888, 0);
     SDL_FreeSurface(loaded);
     if (!surface) {
-        SDL_Log("Failed to convert surface to ABGR8888: %s", SDL_GetError());
+        LOG_ERROR(Render, "Failed to convert surface to ABGR8888: %s", SDL_GetError());
+        return nullptr;
+    }
+
+    return surface;
+}
+
+bool Texture::Load(const std::string &filePath)
+{
+    SDL_Surface* surface = LoadSurface(filePath);
+    if (!surface) {
         return false;
     }
 
+    Load(surface);
+    SDL_FreeSurface(surface);
+
+    return true;
+}
+
+void Texture::Load(SDL_Surface* surface)
+{
+    mPage = nullptr;
+    mAtlasRect = Vector4::UnitRect;
+    mIsPending = false;
     mWidth = surface->w;
     mHeight = surface->h;
 
@@ -50,17 +75,13 @@ bool Texture::Load(const std::string &filePath)
     );
 
     glBindTexture(GL_TEXTURE_2D, 0);
-
-    SDL_FreeSurface(surface);
-
-    return true;
 }
 
 void Texture::CreateFromSurface(SDL_Surface* surface)
 {
     SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ABGR8888, 0);
     if (!converted) {
-        SDL_Log("Failed to convert surface to ABGR8888: %s", SDL_GetError());
+        LOG_ERROR(Render, "Failed to convert surface to ABGR8888: %s", SDL_GetError());
         return;
     }
 
@@ -79,15 +100,63 @@ void Texture::CreateFromSurface(SDL_Surface* surface)
     SDL_FreeSurface(converted);
 }
 
+void Texture::CreateEmpty(int width, int height)
+{
+    mWidth = width;
+    mHeight = height;
+
+    glGenTextures(1, &mTextureID);
+    glBindTexture(GL_TEXTURE_2D, mTextureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, mWidth, mHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Texture::UpdateRegion(int x, int y, SDL_Surface* surface)
+{
+    glBindTexture(GL_TEXTURE_2D, mTextureID);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, surface->pitch / 4);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, surface->w, surface->h, GL_RGBA, GL_UNSIGNED_BYTE, surface->pixels);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Texture::SetAtlasRegion(const Texture* page, const Vector4& rect, int width, int height)
+{
+    mPage = page;
+    mAtlasRect = rect;
+    mIsPending = false;
+    mWidth = width;
+    mHeight = height;
+}
+
+void Texture::SetPending(const Texture* placeholder)
+{
+    mPage = placeholder;
+    mAtlasRect = Vector4::UnitRect;
+    mIsPending = true;
+}
+
 void Texture::Unload()
 {
-	glDeleteTextures(1, &mTextureID);
+    // Atlas regions don't own their page's texture
+    if (!mPage)
+    {
+        glDeleteTextures(1, &mTextureID);
+    }
+    mTextureID = 0;
 }
 
 void Texture::SetActive(int index) const
 {
     glActiveTexture(GL_TEXTURE0 + index);
 
-    glBindTexture(GL_TEXTURE_2D, mTextureID);
+    glBindTexture(GL_TEXTURE_2D, GetTextureID());
 }
 
@@ -3,6 +3,7 @@
 #include <GL/glew.h>
 #include <SDL.h>
 #include <SDL_image.h>
+#include "../Math.h"
 
 class Texture
 {
@@ -11,10 +12,39 @@ public:
 	~Texture();
 
 	bool Load(const std::string &fileName);
+	// Uploads an ABGR8888 surface (as returned by LoadSurface); the caller keeps ownership
+	void Load(SDL_Surface *surface);
 	void Unload();
 
 	void CreateFromSurface(struct SDL_Surface *surface);
 
+	// Decodes an image file into an ABGR8888 surface the caller must free (null on failure)
+	static SDL_Surface* LoadSurface(const std::string &filePath);
+
+	// Empty RGBA texture whose contents are filled with UpdateRegion
+	void CreateEmpty(int width, int height);
+	void UpdateRegion(int x, int y, SDL_Surface *surface);
+
+	// Makes this texture a width x height sub-rect of an atlas page; rect is normalized
+	void SetAtlasRegion(const Texture *page, const Vector4 &rect, int width, int height);
+
+	// Draws as placeholder until Load or SetAtlasRegion gives it its own pixels
+	void SetPending(const Texture *placeholder);
+	bool IsPending() const { return mIsPending; }
+
+	// Texture actually bound when drawing this one (itself unless it lives in an atlas)
+	const Texture* GetPage() const { return mPage ? mPage : this; }
+
+	// Normalized sub-rect of the page covered by this texture
+	const Vector4& GetAtlasRect() const { return mAtlasRect; }
+
+	// Maps a rect normalized to this texture into page coordinates
+	Vector4 MapRect(const Vector4 &rect) const
+	{
+		return Vector4(mAtlasRect.x + rect.x * mAtlasRect.z, mAtlasRect.y + rect.y * mAtlasRect.w,
+		               rect.z * mAtlasRect.z, rect.w * mAtlasRect.w);
+	}
+
 	void SetActive(int index = 0) const;
 
 	static GLenum SDLFormatToGL(SDL_PixelFormat *fmt);
@@ -22,10 +52,14 @@ public:
 	int GetWidth() const { return mWidth; }
 	int GetHeight() const { return mHeight; }
 
-	unsigned int GetTextureID() const { return mTextureID; }
+	unsigned int GetTextureID() const { return GetPage()->mTextureID; }
 
 private:
 	unsigned int mTextureID;
 	int mWidth;
 	int mHeight;
+
+	const Texture* mPage;
+	Vector4 mAtlasRect;
+	bool mIsPending;
 };
@@ -0,0 +1,159 @@
+//
+// TextureAtlas.cpp
+//
+
+#include "TextureAtlas.h"
+#include <algorithm>
+#include "Texture.h"
+
+TextureAtlas::TextureAtlas()
+{
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    Unload();
+}
+
+bool TextureAtlas::Add(SDL_Surface* surface, Texture* outTexture)
+{
+    if (surface->w > MAX_ENTRY_SIZE || surface->h > MAX_ENTRY_SIZE)
+    {
+        return false;
+    }
+
+    const int width = surface->w + PADDING;
+    const int height = surface->h + PADDING;
+
+    int x = 0, y = 0;
+    size_t node = 0;
+    Page* page = nullptr;
+    for (auto& candidate : mPages)
+    {
+        if (FindPosition(candidate, width, height, x, y, node))
+        {
+            page = &candidate;
+            break;
+        }
+    }
+
+    if (!page)
+    {
+        page = &AddPage();
+        FindPosition(*page, width, height, x, y, node);
+    }
+
+    Insert(*page, node, x, y, width, height);
+    page->texture->UpdateRegion(x, y, surface);
+
+    const float invSize = 1.0f / static_cast<float>(PAGE_SIZE);
+    outTexture->SetAtlasRegion(page->texture,
+                               Vector4(x * invSize, y * invSize, surface->w * invSize, surface->h * invSize),
+                               surface->w, surface->h);
+    return true;
+}
+
+void TextureAtlas::Unload()
+{
+    for (auto& page : mPages)
+    {
+        page.texture->Unload();
+        delete page.texture;
+    }
+    mPages.clear();
+}
+
+TextureAtlas::Page& TextureAtlas::AddPage()
+{
+    Page page;
+    page.texture = new Texture();
+    page.texture->CreateEmpty(PAGE_SIZE, PAGE_SIZE);
+    page.skyline.emplace_back(SkylineNode{0, 0, PAGE_SIZE});
+
+    mPages.emplace_back(std::move(page));
+    return mPages.back();
+}
+
+bool TextureAtlas::FindPosition(const Page& page, const int width, const int height,
+                                int& outX, int& outY, size_t& outNode)
+{
+    int bestY = PAGE_SIZE;
+    int bestWidth = PAGE_SIZE + 1;
+    bool found = false;
+
+    for (size_t i = 0; i < page.skyline.size(); ++i)
+    {
+        const int x = page.skyline[i].x;
+        if (x + width > PAGE_SIZE)
+        {
+            break;
+        }
+
+        // The box rests on the highest node it spans
+        int y = 0;
+        int widthLeft = width;
+        for (size_t j = i; widthLeft > 0; ++j)
+        {
+            y = std::max(y, page.skyline[j].y);
+            widthLeft -= page.skyline[j].width;
+        }
+
+        if (y + height > PAGE_SIZE)
+        {
+            continue;
+        }
+
+        // Lowest position first, then the tightest node to limit wasted space
+        if (y < bestY || (y == bestY && page.skyline[i].width < bestWidth))
+        {
+            bestY = y;
+            bestWidth = page.skyline[i].width;
+            outX = x;
+            outY = y;
+            outNode = i;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+void TextureAtlas::Insert(Page& page, const size_t node, const int x, const int y, const int width, const int height)
+{
+    auto& skyline = page.skyline;
+    skyline.insert(skyline.begin() + node, SkylineNode{x, y + height, width});
+
+    // Trim or drop the nodes now covered by the new one
+    for (size_t i = node + 1; i < skyline.size();)
+    {
+        const int coveredEnd = skyline[i - 1].x + skyline[i - 1].width;
+        if (skyline[i].x >= coveredEnd)
+        {
+            break;
+        }
+
+        const int shrink = coveredEnd - skyline[i].x;
+        skyline[i].x += shrink;
+        skyline[i].width -= shrink;
+        if (skyline[i].width > 0)
+        {
+            break;
+        }
+
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // Merge neighbours left at the same height
+    for (size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
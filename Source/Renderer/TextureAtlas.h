@@ -0,0 +1,53 @@
+//
+// TextureAtlas.h
+//
+
+#pragma once
+#include <vector>
+#include <SDL.h>
+
+// Packs small images into a few shared texture pages (skyline bottom-left),
+// so sprites from different files can be drawn without rebinding textures.
+class TextureAtlas
+{
+public:
+    static const int PAGE_SIZE = 1024;
+    // Images larger than this on either side keep their own texture
+    static const int MAX_ENTRY_SIZE = 256;
+    // Gap left between packed images so filtering never samples a neighbour
+    static const int PADDING = 1;
+
+    TextureAtlas();
+    ~TextureAtlas();
+
+    // Copies surface into a page and turns outTexture into a region of it;
+    // returns false if the image is too large to be packed
+    bool Add(SDL_Surface* surface, class Texture* outTexture);
+
+    void Unload();
+
+    size_t GetNumPages() const { return mPages.size(); }
+
+private:
+    // Top edge of the packed area over [x, x + width)
+    struct SkylineNode
+    {
+        int x;
+        int y;
+        int width;
+    };
+
+    struct Page
+    {
+        class Texture* texture;
+        std::vector<SkylineNode> skyline;
+    };
+
+    // Lowest spot where a width x height box fits; false if the page is full
+    static bool FindPosition(const Page& page, int width, int height, int& outX, int& outY, size_t& outNode);
+    static void Insert(Page& page, size_t node, int x, int y, int width, int height);
+
+    Page& AddPage();
+
+    std::vector<Page> mPages;
+};
@@ -0,0 +1,100 @@
+//
+// TextureLoader.cpp
+//
+
+#include "TextureLoader.h"
+#include "Texture.h"
+
+TextureLoader::TextureLoader(const unsigned int numThreads)
+    : mStopping(false)
+    , mInFlight(0)
+{
+    for (unsigned int i = 0; i < numThreads; ++i)
+    {
+        mWorkers.emplace_back(&TextureLoader::WorkerLoop, this);
+    }
+}
+
+TextureLoader::~TextureLoader()
+{
+    Shutdown();
+}
+
+void TextureLoader::Request(Texture* texture, const std::string& fileName)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending.emplace_back(Result{texture, fileName, nullptr});
+        mInFlight++;
+    }
+    mWakeWorkers.notify_one();
+}
+
+bool TextureLoader::Collect(std::vector<Result>& out, const size_t byteBudget)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    size_t bytes = 0;
+    while (!mDone.empty() && (bytes < byteBudget || out.empty()))
+    {
+        const Result& result = mDone.front();
+        if (result.surface)
+        {
+            bytes += static_cast<size_t>(result.surface->pitch) * result.surface->h;
+        }
+
+        out.emplace_back(result);
+        mDone.pop_front();
+        mInFlight--;
+    }
+
+    return mInFlight > 0;
+}
+
+void TextureLoader::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mWakeWorkers.notify_all();
+
+    for (auto& worker : mWorkers)
+    {
+        worker.join();
+    }
+    mWorkers.clear();
+
+    for (auto& result : mDone)
+    {
+        SDL_FreeSurface(result.surface);
+    }
+    mDone.clear();
+    mPending.clear();
+    mInFlight = 0;
+}
+
+void TextureLoader::WorkerLoop()
+{
+    while (true)
+    {
+        Result job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeWorkers.wait(lock, [this] { return mStopping || !mPending.empty(); });
+            if (mStopping)
+            {
+                return;
+            }
+
+            job = std::move(mPending.front());
+            mPending.pop_front();
+        }
+
+        // The slow part (file read, PNG/JPG decode, format conversion) runs unlocked
+        job.surface = Texture::LoadSurface(job.fileName);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mDone.emplace_back(std::move(job));
+    }
+}
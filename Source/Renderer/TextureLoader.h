@@ -0,0 +1,52 @@
+//
+// TextureLoader.h
+//
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SDL.h>
+
+// Decodes image files on worker threads. Finished surfaces wait in a queue
+// until the game thread, which owns the GL context, collects them for upload.
+class TextureLoader
+{
+public:
+    struct Result
+    {
+        class Texture* texture;
+        std::string fileName;
+        // Null when decoding failed
+        SDL_Surface* surface;
+    };
+
+    explicit TextureLoader(unsigned int numThreads = 2);
+    ~TextureLoader();
+
+    // Queues fileName to be decoded for texture
+    void Request(class Texture* texture, const std::string& fileName);
+
+    // Moves finished decodes into out until their pixels exceed byteBudget
+    // (at least one is always taken); returns false once nothing is in flight
+    bool Collect(std::vector<Result>& out, size_t byteBudget);
+
+    // Stops the workers and frees every surface not collected yet
+    void Shutdown();
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> mWorkers;
+
+    std::mutex mMutex;
+    std::condition_variable mWakeWorkers;
+    bool mStopping;
+
+    std::deque<Result> mPending;
+    std::deque<Result> mDone;
+    size_t mInFlight;
+};
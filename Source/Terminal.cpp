@@ -4,37 +4,32 @@
 #include "Terminal.h"
 #include "./Renderer/Renderer.h"
 #include "./Renderer/Font.h"
+#include "./Renderer/FontRegistry.h"
 #include "./Renderer/Texture.h"
 #include "./Game.h" // para Game::WINDOW_WIDTH / HEIGHT
 #include <SDL_ttf.h>
+#include "./Utils/Profiler.h"
+#include "./Utils/Log.h"
 
 Terminal::Terminal(Renderer *renderer, const std::string &fontPath, int pointSize, int maxLines)
-    : mRenderer(renderer), mFont(nullptr), mFontPath(fontPath), mPointSize(pointSize), mMaxLines(maxLines),
+    : mRenderer(renderer), mFontPath(fontPath), mPointSize(pointSize), mMaxLines(maxLines),
       mActive(true), mCursorBlink(0.0f), mCursorOn(true)
 {
-    // Cria e carrega a Font (aloca dinamicamente para compatibilidade)
-    mFont = new Font();
-    if (!mFont->Load(mFontPath))
+    // Fonte compartilhada: terminais recriados a cada fase reaproveitam a mesma
+    mFont = FontRegistry::Acquire(mFontPath);
+    if (!mFont)
     {
-        SDL_Log("Terminal: falha ao carregar fonte %s", mFontPath.c_str());
-        delete mFont;
-        mFont = nullptr;
+        LOG_ERROR(Terminal, "Terminal: falha ao carregar fonte %s", mFontPath.c_str());
     }
 
     // inicia histórico com uma linha com prompt (opcional)
     mLines.clear();
     mBuffer.clear();
-    mLastCommand.clear();
+    mPendingCommands.clear();
 }
 
 Terminal::~Terminal()
 {
-    if (mFont)
-    {
-        mFont->Unload();
-        delete mFont;
-        mFont = nullptr;
-    }
 }
 
 void Terminal::Toggle()
@@ -154,7 +149,7 @@ void Terminal::SubmitLine() {
         if (static_cast<int>(mLines.size()) > mMaxLines - 1) {
             mLines.pop_front();
         }
-        mLastCommand = mBuffer;
+        mPendingCommands.push_back(mBuffer);
 
         mHistory.push_back(mBuffer);
         mHistoryIndex = -1; // reset navegação
@@ -163,15 +158,20 @@ void Terminal::SubmitLine() {
     }
 }
 
-std::string Terminal::ConsumeCommand()
+bool Terminal::ConsumeCommand(std::string &outCommand)
 {
-    std::string tmp = mLastCommand;
-    mLastCommand.clear();
-    return tmp;
+    if (mPendingCommands.empty())
+        return false;
+
+    outCommand = std::move(mPendingCommands.front());
+    mPendingCommands.pop_front();
+    return true;
 }
 
 void Terminal::Draw()
 {
+    PROFILE_SCOPE("Terminal::Draw");
+
     if (!mFont)
         return;
 
@@ -198,31 +198,12 @@ void Terminal::Draw()
 
     for (const auto &ln : mLines)
     {
-        Texture *tex = mFont->RenderText(ln, Vector3(1, 1, 1), mPointSize);
-        if (!tex)
+        if (ln.empty())
             continue;
 
-        float texW = static_cast<float>(tex->GetWidth());
-        float texH = static_cast<float>(tex->GetHeight());
-
-        if (texW <= maxPixels)
-        {
-            Vector2 centerPos(drawX + texW * 0.5f, drawY + texH * 0.5f);
-            mRenderer->DrawTexture(centerPos, Vector2(texW, texH), 0.0f,
-                                   Vector3(1, 1, 1), tex, Vector4(0, 0, 1, 1),
-                                   Vector2::Zero, false, 1.0f);
-        }
-        else
-        {
-            float u0 = (texW - maxPixels) / texW;
-            Vector4 uv(u0, 0.0f, 1.0f, 1.0f);
-            Vector2 size(maxPixels, texH);
-            Vector2 centerPos(drawX + maxPixels * 0.5f, drawY + texH * 0.5f);
-            mRenderer->DrawTexture(centerPos, size, 0.0f,
-                                   Vector3(1, 1, 1), tex, uv, Vector2::Zero, false, 1.0f);
-        }
-        tex->Unload();
-        delete tex;
+        // Lines wider than the panel show their end, like the prompt
+        mFont->DrawText(mRenderer, ln, Vector2(drawX, drawY), Vector3(1, 1, 1), mPointSize,
+                        Vector2::Zero, maxPixels);
 
         drawY += lineHeight;
         if (drawY + lineHeight > top + height - padY)
@@ -230,31 +211,8 @@ void Terminal::Draw()
     }
 
     std::string prompt = "mioware@user:~$ " + mBuffer + (mCursorOn ? "_" : " ");
-    Texture *ptex = mFont->RenderText(prompt, Vector3(1, 1, 1), mPointSize);
-    if (ptex)
-    {
-        float texW = static_cast<float>(ptex->GetWidth());
-        float texH = static_cast<float>(ptex->GetHeight());
-
-        if (texW <= maxPixels)
-        {
-            Vector2 centerPos(drawX + texW * 0.5f, drawY + texH * 0.5f);
-            mRenderer->DrawTexture(centerPos, Vector2(texW, texH), 0.0f,
-                                   Vector3(1, 1, 1), ptex, Vector4(0, 0, 1, 1),
-                                   Vector2::Zero, false, 1.0f);
-        }
-        else
-        {
-            float u0 = (texW - maxPixels) / texW;
-            Vector4 uv(u0, 0.0f, 1.0f, 1.0f);
-            Vector2 size(maxPixels, texH);
-            Vector2 centerPos(drawX + maxPixels * 0.5f, drawY + texH * 0.5f);
-            mRenderer->DrawTexture(centerPos, size, 0.0f,
-                                   Vector3(1, 1, 1), ptex, uv, Vector2::Zero, false, 1.0f);
-        }
-        ptex->Unload();
-        delete ptex;
-    }
+    mFont->DrawText(mRenderer, prompt, Vector2(drawX, drawY), Vector3(1, 1, 1), mPointSize,
+                    Vector2::Zero, maxPixels);
 
     this->DrawHelper(left, top, width);
 
@@ -315,8 +273,34 @@ void Terminal::AddLine(const std::string &line)
 void Terminal::DrawHelper(float left, float top, float width)
 {
     {
+        const char *helpLines[] = {
+            "Commands:",
+            "  jump",
+            "  get <objName>",
+            "  set <objName|selector> <attr> <value>",
+            "  delete (rm) <objName|selector>",
+            "  list (ls) [selector]",
+            "  run (exec) <scriptFile>",
+            "  trace [file]",
+            "  log [category] [level]",
+            "Selectors:",
+            "  dog*, box?, crate[1-12]    glob",
+            "  @inrect(x,y,w,h)           area",
+            "Attributes (attr):",
+            "  rotation (r)     value: x            (float)",
+            "  position (p)    value: (x,y)        (floats)",
+            "  scale (s)       value: (x,y)        (floats)",
+        };
+
+        // o painel cresce para caber todas as linhas
         float panelWidth = 350.0f;
-        float panelHeight = 240.0f;
+        float panelHeight = 20.0f;
+        for (const char *line : helpLines)
+        {
+            const Vector2 size = mFont->MeasureText(line, mPointSize);
+            panelWidth = std::max(panelWidth, size.x + 20.0f);
+            panelHeight += size.y + 4.0f;
+        }
 
         // canto direito do terminal
         float px = left + width - panelWidth - 10.0f;
@@ -331,45 +315,13 @@ void Terminal::DrawHelper(float left, float top, float width)
             Vector2::Zero,
             RendererMode::TRIANGLES);
 
-        const char *helpLines[] = {
-            "Commands:",
-            "  jump",
-            "  get <objName>",
-            "  set <objName> <attr> <value>",
-            "  delete <objName>",
-            "  list",
-            "Attributes (attr):",
-            "  rotation (r)     value: x            (float)",
-            "  position (p)    value: (x,y)        (floats)",
-            "  scale (s)       value: (x,y)        (floats)",
-        };
-
         float textX = px + 10.0f;
         float textY = py + 10.0f;
 
         for (const char *line : helpLines)
         {
-            Texture *tex = mFont->RenderText(line, Vector3(1, 1, 1), mPointSize);
-            if (tex)
-            {
-                float w = (float)tex->GetWidth();
-                float h = (float)tex->GetHeight();
-
-                mRenderer->DrawTexture(
-                    Vector2(textX + w * 0.5f, textY + h * 0.5f),
-                    Vector2(w, h),
-                    0.0f,
-                    Vector3(1, 1, 1),
-                    tex,
-                    Vector4(0, 0, 1, 1),
-                    Vector2::Zero,
-                    false,
-                    1.0f);
-
-                tex->Unload();
-                delete tex;
-                textY += h + 4.0f;
-            }
+            const Vector2 size = mFont->DrawText(mRenderer, line, Vector2(textX, textY), Vector3(1, 1, 1), mPointSize);
+            textY += size.y + 4.0f;
         }
     }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 // Created by Hector on 25/11/2025.
 //
 #pragma once
+#include <memory>
 #include <string>
 #include <deque>
 #include <SDL.h>
@@ -30,7 +31,8 @@ public:
 
   void Draw();
 
-  std::string ConsumeCommand();
+  // Pops the oldest submitted line not handled yet; false if there is none
+  bool ConsumeCommand(std::string &outCommand);
 
 private:
   void AppendChar(const std::string &utf8);
@@ -40,7 +42,7 @@ private:
   std::vector<std::string> WrapText(const std::string& text, float maxPixels);
 
   Renderer *mRenderer;
-  Font *mFont;
+  std::shared_ptr<Font> mFont;
   std::string mFontPath;
   int mPointSize;
   int mMaxLines;
@@ -48,7 +50,7 @@ private:
   bool mActive;
   std::deque<std::string> mLines;
   std::string mBuffer;
-  std::string mLastCommand;
+  std::deque<std::string> mPendingCommands;
 
   float mCursorBlink;
   bool mCursorOn;
@@ -0,0 +1,254 @@
+//
+// CommandDispatcher.cpp
+//
+
+#include "CommandDispatcher.h"
+#include "Log.h"
+#include "TerminalHelper.h"
+#include <cassert>
+#include <charconv>
+#include <SDL.h>
+
+namespace
+{
+    bool IsSpace(const char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    std::string_view Trim(std::string_view text)
+    {
+        while (!text.empty() && IsSpace(text.front()))
+            text.remove_prefix(1);
+        while (!text.empty() && IsSpace(text.back()))
+            text.remove_suffix(1);
+        return text;
+    }
+
+    // Next whitespace-separated token; a parenthesized group is one token even with spaces inside
+    std::string_view NextToken(std::string_view& text)
+    {
+        text = Trim(text);
+
+        size_t end = 0;
+        if (!text.empty() && text.front() == '(')
+        {
+            end = text.find(')');
+            end = end == std::string_view::npos ? text.size() : end + 1;
+        }
+        else
+        {
+            // Parentheses inside a word, as in "@inrect(0, 0, 64, 64)", may hold spaces
+            while (end < text.size() && !IsSpace(text[end]))
+            {
+                if (text[end] == '(')
+                {
+                    const size_t close = text.find(')', end);
+                    end = close == std::string_view::npos ? text.size() - 1 : close;
+                }
+                ++end;
+            }
+        }
+
+        const std::string_view token = text.substr(0, end);
+        text.remove_prefix(end);
+        return token;
+    }
+}
+
+CommandDispatcher::CommandDispatcher()
+{
+    mTrie.emplace_back(TrieNode{'\0'});
+}
+
+void CommandDispatcher::Register(std::string_view name, std::initializer_list<std::string_view> aliases,
+                                 std::initializer_list<CommandArgType> schema, int numRequired,
+                                 std::string usage, Handler handler)
+{
+    assert(schema.size() <= CommandArgs::MAX_ARGS);
+
+    const int command = static_cast<int>(mCommands.size());
+    mCommands.emplace_back(Command{schema, numRequired, std::move(usage), std::move(handler)});
+
+    AddName(name, command);
+    for (const std::string_view alias : aliases)
+    {
+        AddName(alias, command);
+    }
+}
+
+void CommandDispatcher::AddName(std::string_view name, int command)
+{
+    int node = 0;
+    for (const char c : name)
+    {
+        const char folded = FoldCase(c);
+        int child = FindChild(node, folded);
+        if (child < 0)
+        {
+            child = static_cast<int>(mTrie.size());
+            // Emplacing may reallocate, so link through indices only
+            mTrie.emplace_back(TrieNode{folded, -1, mTrie[node].firstChild});
+            mTrie[node].firstChild = child;
+        }
+        node = child;
+    }
+
+    mTrie[node].command = command;
+}
+
+int CommandDispatcher::FindChild(const int node, const char c) const
+{
+    for (int child = mTrie[node].firstChild; child >= 0; child = mTrie[child].nextSibling)
+    {
+        if (mTrie[child].c == c)
+            return child;
+    }
+    return -1;
+}
+
+const CommandDispatcher::Command* CommandDispatcher::Find(std::string_view name) const
+{
+    int node = 0;
+    for (const char c : name)
+    {
+        node = FindChild(node, FoldCase(c));
+        if (node < 0)
+            return nullptr;
+    }
+
+    const int command = mTrie[node].command;
+    return command >= 0 ? &mCommands[command] : nullptr;
+}
+
+int CommandDispatcher::Execute(std::string_view text)
+{
+    int executed = 0;
+    while (!text.empty())
+    {
+        size_t end = text.find_first_of(";#\n");
+        std::string_view statement = text.substr(0, end);
+
+        // A comment runs to the end of its line, swallowing any ';'
+        if (end != std::string_view::npos && text[end] == '#')
+            end = text.find('\n', end);
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+        statement = Trim(statement);
+        if (!statement.empty() && ExecuteStatement(statement))
+            ++executed;
+    }
+    return executed;
+}
+
+bool CommandDispatcher::ExecuteFile(const std::string& fileName)
+{
+    // A script that runs itself (directly or through others) would never return
+    if (mScriptDepth >= MAX_SCRIPT_DEPTH)
+    {
+        Print("Error: scripts nested more than " + std::to_string(MAX_SCRIPT_DEPTH) + " deep, not running " + fileName);
+        return true;
+    }
+
+    SDL_RWops* file = SDL_RWFromFile(fileName.c_str(), "rb");
+    if (!file)
+        return false;
+
+    const Sint64 size = SDL_RWsize(file);
+    std::string script(size > 0 ? static_cast<size_t>(size) : 0, '\0');
+    const size_t read = script.empty() ? 0 : SDL_RWread(file, &script[0], 1, script.size());
+    SDL_RWclose(file);
+
+    if (read != script.size())
+        return false;
+
+    mScriptDepth++;
+    Execute(script);
+    mScriptDepth--;
+    return true;
+}
+
+bool CommandDispatcher::ExecuteStatement(std::string_view statement)
+{
+    const std::string_view name = NextToken(statement);
+    const Command* command = Find(name);
+    if (!command)
+    {
+        Print("Unknown command: " + std::string(name));
+        return false;
+    }
+
+    CommandArgs args;
+    for (const CommandArgType type : command->schema)
+    {
+        const std::string_view token = NextToken(statement);
+        if (token.empty())
+            break;
+
+        if (!ParseArg(token, type, args.args[args.count]))
+        {
+            Print("Error: invalid argument '" + std::string(token) + "'. " + command->usage);
+            return false;
+        }
+        args.count++;
+    }
+
+    // Leftover tokens are most likely a typo; running without them would hide it
+    if (args.count < command->numRequired || !NextToken(statement).empty())
+    {
+        Print(command->usage);
+        return false;
+    }
+
+    command->handler(args);
+    return true;
+}
+
+bool CommandDispatcher::ParseNumber(std::string_view token, float& out)
+{
+    token = Trim(token);
+    if (!token.empty() && token.front() == '+')
+        token.remove_prefix(1);
+
+    const char* end = token.data() + token.size();
+    const auto [next, error] = std::from_chars(token.data(), end, out);
+    return error == std::errc() && next == end && !token.empty();
+}
+
+bool CommandDispatcher::ParseArg(const std::string_view token, const CommandArgType type, CommandArg& out)
+{
+    out.text = token;
+
+    const bool isVector = token.size() >= 2 && token.front() == '(' && token.back() == ')';
+    if (type == CommandArgType::Vector2 || (type == CommandArgType::Value && isVector))
+    {
+        if (!isVector)
+            return false;
+
+        const std::string_view inside = token.substr(1, token.size() - 2);
+        const size_t comma = inside.find(',');
+        if (comma == std::string_view::npos)
+            return false;
+
+        out.type = CommandArgType::Vector2;
+        return ParseNumber(inside.substr(0, comma), out.vector.x) &&
+               ParseNumber(inside.substr(comma + 1), out.vector.y);
+    }
+
+    if (type == CommandArgType::Number || type == CommandArgType::Value)
+    {
+        out.type = CommandArgType::Number;
+        return ParseNumber(token, out.number);
+    }
+
+    out.type = CommandArgType::Word;
+    return true;
+}
+
+void CommandDispatcher::Print(const std::string& line) const
+{
+    if (mOutput)
+        mOutput(line);
+    else
+        LOG_INFO(Terminal, "%s", line.c_str());
+}
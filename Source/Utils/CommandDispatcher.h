@@ -0,0 +1,108 @@
+//
+// CommandDispatcher.h
+//
+
+#pragma once
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../Math.h"
+
+enum class CommandArgType
+{
+    Word,
+    Number,
+    Vector2,    // "(x,y)"
+    Value       // Number or Vector2, whichever the token is
+};
+
+// One parsed argument; text points into the line being executed
+struct CommandArg
+{
+    // What the token was parsed as (Number or Vector2 for Value arguments)
+    CommandArgType type = CommandArgType::Word;
+    std::string_view text;
+    float number = 0.0f;
+    Vector2 vector;
+};
+
+struct CommandArgs
+{
+    static const int MAX_ARGS = 4;
+
+    CommandArg args[MAX_ARGS];
+    int count = 0;
+
+    bool Has(int index) const { return index < count; }
+    const CommandArg& operator[](int index) const { return args[index]; }
+};
+
+// Table of terminal commands. Names and aliases are looked up case-insensitively
+// in a trie, and each command declares the types of its arguments, so handlers
+// receive them already validated and parsed.
+class CommandDispatcher
+{
+public:
+    using Handler = std::function<void(const CommandArgs& args)>;
+    using Output = std::function<void(const std::string& line)>;
+
+    CommandDispatcher();
+
+    // The first numRequired arguments of schema must be given and nothing past the
+    // schema may follow; usage is printed otherwise
+    void Register(std::string_view name, std::initializer_list<std::string_view> aliases,
+                  std::initializer_list<CommandArgType> schema, int numRequired,
+                  std::string usage, Handler handler);
+
+    // Where errors, usage messages and handler output go
+    void SetOutput(Output output) { mOutput = std::move(output); }
+    // Writes a line to the output (the log when none is set)
+    void Print(const std::string& line) const;
+
+    // Runs every command in text. Commands are separated by ';' or new lines and
+    // '#' comments out the rest of a line. Returns how many commands ran.
+    int Execute(std::string_view text);
+
+    // Scripts may run other scripts, up to this many files deep
+    static const int MAX_SCRIPT_DEPTH = 8;
+
+    // Execute over a whole file; false if it can't be read. Past
+    // MAX_SCRIPT_DEPTH nested files an error is printed instead.
+    bool ExecuteFile(const std::string& fileName);
+
+private:
+    struct Command
+    {
+        std::vector<CommandArgType> schema;
+        int numRequired;
+        std::string usage;
+        Handler handler;
+    };
+
+    // Children of a node are a linked list of siblings
+    struct TrieNode
+    {
+        char c;
+        int firstChild = -1;
+        int nextSibling = -1;
+        int command = -1;
+    };
+
+    void AddName(std::string_view name, int command);
+    int FindChild(int node, char c) const;
+    const Command* Find(std::string_view name) const;
+
+    bool ExecuteStatement(std::string_view statement);
+
+    static bool ParseArg(std::string_view token, CommandArgType type, CommandArg& out);
+    static bool ParseNumber(std::string_view token, float& out);
+
+    std::vector<Command> mCommands;
+    // Node 0 is the root
+    std::vector<TrieNode> mTrie;
+    Output mOutput;
+    // Files being executed, outermost first
+    int mScriptDepth = 0;
+};
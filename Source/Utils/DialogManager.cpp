@@ -9,8 +9,34 @@
 
 #include "../Terminal.h"
 
+std::mutex DialogManager::sMutex;
+std::unordered_map<std::string, std::shared_ptr<const DialogTable>> DialogManager::sTables;
+
 void DialogManager::LoadDialogs(const std::string &dialogFilePath)
 {
+    mDialogs = Load(dialogFilePath);
+}
+
+std::shared_ptr<const DialogTable> DialogManager::Load(const std::string &dialogFilePath)
+{
+    {
+        std::lock_guard<std::mutex> lock(sMutex);
+        auto iter = sTables.find(dialogFilePath);
+        if (iter != sTables.end())
+            return iter->second;
+    }
+
+    auto dialogs = std::make_shared<const DialogTable>(ParseDialogs(dialogFilePath));
+
+    std::lock_guard<std::mutex> lock(sMutex);
+    // Another thread may have parsed the same file meanwhile; keep the first copy
+    return sTables.emplace(dialogFilePath, std::move(dialogs)).first->second;
+}
+
+DialogTable DialogManager::ParseDialogs(const std::string &dialogFilePath)
+{
+    DialogTable dialogs;
+
     // Load JSON from file
     std::ifstream file(dialogFilePath);
     if (!file.is_open())
@@ -33,13 +59,15 @@ void DialogManager::LoadDialogs(const std::string &dialogFilePath)
         }
 
         // Store in map
-        mDialogs[key] = std::move(lines);
+        dialogs[key] = std::move(lines);
     }
+
+    return dialogs;
 }
 
 void DialogManager::PlayDialog(const DialogKeys dialogKey)
 {
-    const std::vector<std::string>& dialogLines = mDialogs.at(dialogKey);
+    const std::vector<std::string>& dialogLines = mDialogs->at(dialogKey);
 
     for (const std::string& currentLine : dialogLines)
         mTerminal->AddLine(currentLine);
@@ -3,7 +3,13 @@
 //
 
 #pragma once
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 enum class DialogKeys
 {
@@ -16,11 +22,16 @@ enum class DialogKeys
 
 class Terminal;
 
+using DialogTable = std::map<DialogKeys, std::vector<std::string>>;
+
 class DialogManager
 {
 private:
     Terminal* mTerminal = nullptr;
-    std::map<DialogKeys, std::vector<std::string>> mDialogs;
+    std::shared_ptr<const DialogTable> mDialogs;
+
+    static std::mutex sMutex;
+    static std::unordered_map<std::string, std::shared_ptr<const DialogTable>> sTables;
 
 private:
     void LoadDialogs(const std::string& dialogFilePath);
@@ -42,5 +53,16 @@ public:
         LoadDialogs(dialogFilePath);
     }
 
+    // Takes dialogs loaded ahead of time (e.g. off the main thread while a scene loads)
+    DialogManager(Terminal* terminal, std::shared_ptr<const DialogTable> dialogs) : mTerminal(terminal), mDialogs(std::move(dialogs))
+    {
+    }
+
+    // Reads every dialog in the file; only touches its own data, so it's safe on any thread
+    static DialogTable ParseDialogs(const std::string& dialogFilePath);
+
+    // Parses the file once and hands out the same table afterwards (like LevelCache)
+    static std::shared_ptr<const DialogTable> Load(const std::string& dialogFilePath);
+
     void PlayDialog(DialogKeys dialogKey);
 };
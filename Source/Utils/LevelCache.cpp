@@ -0,0 +1,213 @@
+//
+// LevelCache.cpp
+//
+
+#include "LevelCache.h"
+#include "Log.h"
+#include <charconv>
+#include <cstring>
+#include <SDL.h>
+
+namespace
+{
+    const char BINARY_MAGIC[4] = {'L', 'V', 'L', '1'};
+    const size_t BINARY_HEADER_SIZE = sizeof(BINARY_MAGIC) + 2 * sizeof(uint32_t);
+
+    bool HasExtension(const std::string& fileName, const char* extension)
+    {
+        const size_t length = std::strlen(extension);
+        return fileName.size() >= length && fileName.compare(fileName.size() - length, length, extension) == 0;
+    }
+
+    uint32_t ReadU32(const unsigned char* bytes)
+    {
+        return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+    }
+
+    void WriteU32(std::string& out, const uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+}
+
+std::mutex LevelCache::sMutex;
+std::unordered_map<std::string, std::shared_ptr<const LevelGrid>> LevelCache::sLevels;
+
+std::shared_ptr<const LevelGrid> LevelCache::Load(const std::string& fileName, const int width, const int height)
+{
+    {
+        std::lock_guard<std::mutex> lock(sMutex);
+        auto iter = sLevels.find(fileName);
+        if (iter != sLevels.end())
+        {
+            return iter->second;
+        }
+    }
+
+    std::string data;
+    if (!ReadFile(fileName, data))
+    {
+        LOG_ERROR(Core, "Erro ao abrir o arquivo: %s", fileName.c_str());
+        return nullptr;
+    }
+
+    auto grid = std::make_shared<LevelGrid>();
+    grid->width = width;
+    grid->height = height;
+    grid->tiles.assign(static_cast<size_t>(width) * height, LevelGrid::EMPTY_TILE);
+
+    const bool parsed = HasExtension(fileName, ".lvl") ? ParseBinary(data, *grid) : ParseCSV(data, *grid);
+    if (!parsed)
+    {
+        LOG_ERROR(Core, "Level %s is malformed", fileName.c_str());
+        return nullptr;
+    }
+
+    LOG_INFO(Core, "=== Level carregado de %s ===", fileName.c_str());
+
+    std::lock_guard<std::mutex> lock(sMutex);
+    // Another thread may have parsed the same file meanwhile; keep the first copy
+    return sLevels.emplace(fileName, std::move(grid)).first->second;
+}
+
+void LevelCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(sMutex);
+    sLevels.clear();
+}
+
+bool LevelCache::ReadFile(const std::string& fileName, std::string& outData)
+{
+    SDL_RWops* file = SDL_RWFromFile(fileName.c_str(), "rb");
+    if (!file)
+    {
+        return false;
+    }
+
+    // The whole file in one read; parsing then works in place on the buffer
+    const Sint64 size = SDL_RWsize(file);
+    if (size < 0)
+    {
+        SDL_RWclose(file);
+        return false;
+    }
+
+    outData.resize(static_cast<size_t>(size));
+    const size_t read = size > 0 ? SDL_RWread(file, &outData[0], 1, outData.size()) : 0;
+    SDL_RWclose(file);
+
+    return read == outData.size();
+}
+
+bool LevelCache::ParseCSV(const std::string& data, LevelGrid& grid)
+{
+    const char* cursor = data.data();
+    const char* const end = cursor + data.size();
+
+    int row = 0;
+    int col = 0;
+    while (cursor < end && row < grid.height)
+    {
+        while (cursor < end && (*cursor == ' ' || *cursor == '\t'))
+        {
+            ++cursor;
+        }
+
+        if (cursor < end && *cursor != ',' && *cursor != '\r' && *cursor != '\n')
+        {
+            int value = 0;
+            const auto [next, error] = std::from_chars(cursor, end, value);
+            if (error != std::errc())
+            {
+                return false;
+            }
+
+            // Extra columns are ignored, like missing ones are left empty
+            if (col < grid.width)
+            {
+                grid.tiles[row * grid.width + col] = static_cast<int16_t>(value);
+            }
+            cursor = next;
+        }
+
+        while (cursor < end && (*cursor == ' ' || *cursor == '\t'))
+        {
+            ++cursor;
+        }
+
+        if (cursor == end)
+        {
+            break;
+        }
+
+        if (*cursor == ',')
+        {
+            ++col;
+        }
+        else if (*cursor == '\n')
+        {
+            ++row;
+            col = 0;
+        }
+        else if (*cursor != '\r')
+        {
+            return false;
+        }
+        ++cursor;
+    }
+
+    return true;
+}
+
+bool LevelCache::ParseBinary(const std::string& data, LevelGrid& grid)
+{
+    if (data.size() < BINARY_HEADER_SIZE || std::memcmp(data.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0)
+    {
+        return false;
+    }
+
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+    const uint32_t width = ReadU32(bytes + 4);
+    const uint32_t height = ReadU32(bytes + 8);
+    if (width != static_cast<uint32_t>(grid.width) || height != static_cast<uint32_t>(grid.height) ||
+        data.size() != BINARY_HEADER_SIZE + static_cast<size_t>(width) * height * sizeof(int16_t))
+    {
+        return false;
+    }
+
+    const unsigned char* tile = bytes + BINARY_HEADER_SIZE;
+    for (auto& value : grid.tiles)
+    {
+        value = static_cast<int16_t>(tile[0] | (tile[1] << 8));
+        tile += sizeof(int16_t);
+    }
+
+    return true;
+}
+
+bool LevelCache::WriteBinary(const LevelGrid& grid, const std::string& fileName)
+{
+    std::string data(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    WriteU32(data, static_cast<uint32_t>(grid.width));
+    WriteU32(data, static_cast<uint32_t>(grid.height));
+    for (const int16_t value : grid.tiles)
+    {
+        const auto bits = static_cast<uint16_t>(value);
+        data.push_back(static_cast<char>(bits & 0xFF));
+        data.push_back(static_cast<char>(bits >> 8));
+    }
+
+    SDL_RWops* file = SDL_RWFromFile(fileName.c_str(), "wb");
+    if (!file)
+    {
+        return false;
+    }
+
+    const size_t written = SDL_RWwrite(file, data.data(), 1, data.size());
+    SDL_RWclose(file);
+
+    return written == data.size();
+}
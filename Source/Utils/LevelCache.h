@@ -0,0 +1,50 @@
+//
+// LevelCache.h
+//
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Tile IDs of a level, row-major in one contiguous block (-1 is an empty cell)
+struct LevelGrid
+{
+    static const int EMPTY_TILE = -1;
+
+    int width = 0;
+    int height = 0;
+    std::vector<int16_t> tiles;
+
+    int GetTile(int col, int row) const { return tiles[row * width + col]; }
+};
+
+// Parses each level file once and hands out the same grid afterwards, so restarting
+// a level costs a map lookup. Safe to use from the scene-loading worker.
+//
+// Levels are read either as CSV or, for files ending in ".lvl", in a compact binary
+// layout: the 4-byte magic "LVL1", width and height as little-endian uint32, then
+// width * height little-endian int16 tile IDs.
+class LevelCache
+{
+public:
+    // Grid for fileName (width x height cells), or null if the file can't be read
+    static std::shared_ptr<const LevelGrid> Load(const std::string& fileName, int width, int height);
+
+    // Writes grid in the binary layout above
+    static bool WriteBinary(const LevelGrid& grid, const std::string& fileName);
+
+    // Forgets every parsed level; grids already handed out stay valid
+    static void Clear();
+
+private:
+    static bool ReadFile(const std::string& fileName, std::string& outData);
+    static bool ParseCSV(const std::string& data, LevelGrid& grid);
+    static bool ParseBinary(const std::string& data, LevelGrid& grid);
+
+    static std::mutex sMutex;
+    static std::unordered_map<std::string, std::shared_ptr<const LevelGrid>> sLevels;
+};
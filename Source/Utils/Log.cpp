@@ -0,0 +1,294 @@
+//
+// Log.cpp
+//
+
+#include "Log.h"
+#include "TerminalHelper.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    static_assert((Log::QUEUE_SIZE & (Log::QUEUE_SIZE - 1)) == 0, "QUEUE_SIZE must be a power of two");
+
+    const char* const LEVEL_NAMES[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "OFF"};
+    const char* const CATEGORY_NAMES[] = {"Core", "Render", "Audio", "Gameplay", "Terminal"};
+
+    // Bounded multi-producer queue (Vyukov): each slot's sequence says whether it is
+    // free for the producer at that position or holds a message for the writer
+    struct Message
+    {
+        std::atomic<uint64_t> sequence;
+        uint64_t timeNs;
+        LogCategory category;
+        LogLevel level;
+        char text[Log::MESSAGE_SIZE];
+    };
+
+    struct Queue
+    {
+        Queue()
+        {
+            for (size_t i = 0; i < Log::QUEUE_SIZE; i++)
+                messages[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        Message messages[Log::QUEUE_SIZE];
+        std::atomic<uint64_t> enqueuePos{0};
+        // Only touched by the writer
+        uint64_t dequeuePos = 0;
+    };
+
+    Queue sQueue;
+    std::atomic<uint64_t> sDropped{0};
+
+    std::thread sWriter;
+    std::atomic<bool> sRunning{false};
+    std::atomic<bool> sWriterSleeping{false};
+    std::mutex sWakeMutex;
+    std::condition_variable sWake;
+    FILE* sFile = nullptr;
+
+    uint64_t NowNs()
+    {
+        using namespace std::chrono;
+        static const steady_clock::time_point start = steady_clock::now();
+        return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now() - start).count());
+    }
+
+    FILE* GetOutput()
+    {
+        return sFile ? sFile : stdout;
+    }
+
+    void WriteLine(FILE* out, uint64_t timeNs, LogCategory category, LogLevel level, const char* text)
+    {
+        std::fprintf(out, "[%10.3f] [%s] %s: %s\n", static_cast<double>(timeNs) * 1e-9,
+                     CATEGORY_NAMES[static_cast<int>(category)], LEVEL_NAMES[static_cast<int>(level)], text);
+    }
+
+    // Producer side; null (the message is dropped) if the queue is full
+    Message* BeginEnqueue()
+    {
+        uint64_t pos = sQueue.enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Message& message = sQueue.messages[pos & (Log::QUEUE_SIZE - 1)];
+            const uint64_t sequence = message.sequence.load(std::memory_order_acquire);
+            const int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+            if (diff == 0)
+            {
+                if (sQueue.enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    return &message;
+            }
+            else if (diff < 0)
+            {
+                return nullptr;
+            }
+            else
+            {
+                pos = sQueue.enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool IsQueueEmpty()
+    {
+        const Message& message = sQueue.messages[sQueue.dequeuePos & (Log::QUEUE_SIZE - 1)];
+        return message.sequence.load(std::memory_order_acquire) != sQueue.dequeuePos + 1;
+    }
+
+    // Writer side; returns how many messages were written
+    int DrainQueue()
+    {
+        FILE* out = GetOutput();
+        int written = 0;
+        while (!IsQueueEmpty())
+        {
+            Message& message = sQueue.messages[sQueue.dequeuePos & (Log::QUEUE_SIZE - 1)];
+            WriteLine(out, message.timeNs, message.category, message.level, message.text);
+
+            // Hand the slot back to the producer one lap ahead
+            message.sequence.store(sQueue.dequeuePos + Log::QUEUE_SIZE, std::memory_order_release);
+            sQueue.dequeuePos++;
+            written++;
+        }
+
+        if (written > 0)
+            std::fflush(out);
+        return written;
+    }
+
+    void WriterLoop()
+    {
+        while (sRunning.load(std::memory_order_acquire))
+        {
+            if (DrainQueue() > 0)
+                continue;
+
+            std::unique_lock<std::mutex> lock(sWakeMutex);
+            sWriterSleeping.store(true);
+
+            // A producer that saw the flag unset before we set it won't notify, so look
+            // again; the timeout bounds the delay of any wake-up that still slips past
+            if (IsQueueEmpty() && sRunning.load(std::memory_order_acquire))
+                sWake.wait_for(lock, std::chrono::milliseconds(50));
+
+            sWriterSleeping.store(false);
+        }
+
+        DrainQueue();
+    }
+
+    bool EqualsIgnoreCase(const char* a, const char* b)
+    {
+        for (; *a && *b; a++, b++)
+        {
+            if (FoldCase(*a) != FoldCase(*b))
+                return false;
+        }
+        return *a == *b;
+    }
+}
+
+std::atomic<uint8_t> Log::sLevels[static_cast<int>(LogCategory::Count)] = {
+    {static_cast<uint8_t>(LogLevel::Info)},
+    {static_cast<uint8_t>(LogLevel::Info)},
+    {static_cast<uint8_t>(LogLevel::Info)},
+    {static_cast<uint8_t>(LogLevel::Info)},
+    {static_cast<uint8_t>(LogLevel::Info)},
+};
+
+void Log::Start(const char* filePath)
+{
+    if (sRunning.load())
+        return;
+
+    if (filePath)
+    {
+        sFile = std::fopen(filePath, "w");
+        if (!sFile)
+            std::fprintf(stderr, "Log: could not open %s, writing to stdout\n", filePath);
+    }
+
+    sRunning.store(true, std::memory_order_release);
+    sWriter = std::thread(WriterLoop);
+}
+
+void Log::Stop()
+{
+    if (!sRunning.load())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(sWakeMutex);
+        sRunning.store(false, std::memory_order_release);
+    }
+    sWake.notify_one();
+    sWriter.join();
+
+    // Producers that queued while the writer was finishing
+    DrainQueue();
+
+    const uint64_t dropped = sDropped.load();
+    if (dropped > 0)
+        std::fprintf(GetOutput(), "Log: %llu message(s) dropped (queue full)\n", static_cast<unsigned long long>(dropped));
+
+    if (sFile)
+    {
+        std::fclose(sFile);
+        sFile = nullptr;
+    }
+}
+
+void Log::SetLevel(LogCategory category, LogLevel level)
+{
+    sLevels[static_cast<int>(category)].store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+LogLevel Log::GetLevel(LogCategory category)
+{
+    return static_cast<LogLevel>(sLevels[static_cast<int>(category)].load(std::memory_order_relaxed));
+}
+
+void Log::Write(LogCategory category, LogLevel level, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+
+    if (!sRunning.load(std::memory_order_acquire))
+    {
+        char text[MESSAGE_SIZE];
+        std::vsnprintf(text, sizeof(text), format, args);
+        va_end(args);
+
+        WriteLine(GetOutput(), NowNs(), category, level, text);
+        return;
+    }
+
+    Message* message = BeginEnqueue();
+    if (!message)
+    {
+        va_end(args);
+        sDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    message->timeNs = NowNs();
+    message->category = category;
+    message->level = level;
+    std::vsnprintf(message->text, sizeof(message->text), format, args);
+    va_end(args);
+
+    // Publish: the writer only reads a slot once its sequence moves past the position
+    const uint64_t pos = message->sequence.load(std::memory_order_relaxed);
+    message->sequence.store(pos + 1, std::memory_order_release);
+
+    if (sWriterSleeping.load(std::memory_order_relaxed))
+        sWake.notify_one();
+}
+
+uint64_t Log::GetDroppedCount()
+{
+    return sDropped.load(std::memory_order_relaxed);
+}
+
+const char* Log::GetCategoryName(LogCategory category)
+{
+    return CATEGORY_NAMES[static_cast<int>(category)];
+}
+
+const char* Log::GetLevelName(LogLevel level)
+{
+    return LEVEL_NAMES[static_cast<int>(level)];
+}
+
+bool Log::ParseCategory(const char* name, LogCategory& outCategory)
+{
+    for (int i = 0; i < static_cast<int>(LogCategory::Count); i++)
+    {
+        if (EqualsIgnoreCase(name, CATEGORY_NAMES[i]))
+        {
+            outCategory = static_cast<LogCategory>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Log::ParseLevel(const char* name, LogLevel& outLevel)
+{
+    for (int i = 0; i <= static_cast<int>(LogLevel::Off); i++)
+    {
+        if (EqualsIgnoreCase(name, LEVEL_NAMES[i]))
+        {
+            outLevel = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,109 @@
+//
+// Log.h
+//
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Leveled, per-category logging. Messages are formatted by the caller into a
+// lock-free ring and written to stdout (or a file) by a background thread, so
+// logging from gameplay code never waits on the console.
+//
+// Levels below MIAOWARE_LOG_MIN_LEVEL are compiled out of the LOG_* macros;
+// the rest cost one relaxed load and a branch when filtered at runtime.
+enum class LogLevel : uint8_t
+{
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Off
+};
+
+enum class LogCategory : uint8_t
+{
+    Core,
+    Render,
+    Audio,
+    Gameplay,
+    Terminal,
+    Count
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LOG_PRINTF_FORMAT(formatIndex, firstArg) __attribute__((format(printf, formatIndex, firstArg)))
+#else
+#define LOG_PRINTF_FORMAT(formatIndex, firstArg)
+#endif
+
+class Log
+{
+public:
+    // Longest message kept (longer ones are truncated) and number of queued messages
+    static constexpr size_t MESSAGE_SIZE = 512;
+    static constexpr size_t QUEUE_SIZE = 1024;
+
+    // Starts the writer thread; filePath null means stdout. Messages logged
+    // before Start or after Stop are written synchronously.
+    static void Start(const char* filePath = nullptr);
+    // Writes everything still queued and joins the writer thread
+    static void Stop();
+
+    static void SetLevel(LogCategory category, LogLevel level);
+    static LogLevel GetLevel(LogCategory category);
+
+    static bool IsEnabled(LogCategory category, LogLevel level)
+    {
+        return static_cast<uint8_t>(level) >= sLevels[static_cast<int>(category)].load(std::memory_order_relaxed);
+    }
+
+    static void Write(LogCategory category, LogLevel level, const char* format, ...) LOG_PRINTF_FORMAT(3, 4);
+
+    // Messages lost because the queue was full
+    static uint64_t GetDroppedCount();
+
+    static const char* GetCategoryName(LogCategory category);
+    static const char* GetLevelName(LogLevel level);
+
+    // Parse "audio", "WARN", ... (any letter case); false if unknown
+    static bool ParseCategory(const char* name, LogCategory& outCategory);
+    static bool ParseLevel(const char* name, LogLevel& outLevel);
+
+private:
+    static std::atomic<uint8_t> sLevels[static_cast<int>(LogCategory::Count)];
+};
+
+#ifndef MIAOWARE_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define MIAOWARE_LOG_MIN_LEVEL 2 // Info
+#else
+#define MIAOWARE_LOG_MIN_LEVEL 0 // Trace
+#endif
+#endif
+
+// True if level survives MIAOWARE_LOG_MIN_LEVEL. Compared as LogLevel values: an
+// int comparison against a minimum of 0 trips -Wtype-limits at every LOG_TRACE.
+constexpr bool LogLevelCompiledIn(const LogLevel level)
+{
+    return level >= static_cast<LogLevel>(MIAOWARE_LOG_MIN_LEVEL);
+}
+
+// category is a LogCategory enumerator name, e.g. LOG_INFO(Audio, "Playing %s", name)
+#define LOG_AT(level, category, ...)                                                      \
+    do                                                                                    \
+    {                                                                                     \
+        if constexpr (LogLevelCompiledIn(level))                                          \
+        {                                                                                 \
+            if (Log::IsEnabled(LogCategory::category, level))                             \
+                Log::Write(LogCategory::category, level, __VA_ARGS__);                    \
+        }                                                                                 \
+    } while (0)
+
+#define LOG_TRACE(category, ...) LOG_AT(LogLevel::Trace, category, __VA_ARGS__)
+#define LOG_DEBUG(category, ...) LOG_AT(LogLevel::Debug, category, __VA_ARGS__)
+#define LOG_INFO(category, ...) LOG_AT(LogLevel::Info, category, __VA_ARGS__)
+#define LOG_WARN(category, ...) LOG_AT(LogLevel::Warn, category, __VA_ARGS__)
+#define LOG_ERROR(category, ...) LOG_AT(LogLevel::Error, category, __VA_ARGS__)
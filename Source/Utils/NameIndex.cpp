@@ -0,0 +1,166 @@
+//
+// NameIndex.cpp
+//
+
+#include "NameIndex.h"
+#include "TerminalHelper.h"
+
+NameIndex::NameIndex()
+    : mSlots(16, EMPTY_SLOT)
+    , mNumRemoved(0)
+{
+}
+
+uint32_t NameIndex::Hash(const std::string_view name)
+{
+    // FNV-1a over the lowercased characters
+    uint32_t hash = 2166136261u;
+    for (const char c : name)
+    {
+        hash ^= static_cast<unsigned char>(FoldCase(c));
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool NameIndex::EqualsFolded(const std::string_view folded, const std::string_view name)
+{
+    if (folded.size() != name.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < name.size(); ++i)
+    {
+        if (folded[i] != FoldCase(name[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void NameIndex::Insert(const std::string_view name, const ActorHandle handle)
+{
+    // Keep the table at most 3/4 full, counting removed markers
+    if ((mEntries.size() + mNumRemoved + 1) * 4 > mSlots.size() * 3)
+    {
+        Rehash(mEntries.size() * 2 >= mSlots.size() ? mSlots.size() * 2 : mSlots.size());
+    }
+
+    Entry entry;
+    entry.name.reserve(name.size());
+    for (const char c : name)
+    {
+        entry.name.push_back(FoldCase(c));
+    }
+    entry.handle = handle;
+
+    mEntries.emplace_back(std::move(entry));
+    InsertSlot(Hash(name), static_cast<int32_t>(mEntries.size() - 1));
+}
+
+void NameIndex::Remove(const std::string_view name, const ActorHandle handle)
+{
+    const auto mask = static_cast<uint32_t>(mSlots.size() - 1);
+    uint32_t slot = Hash(name) & mask;
+    for (;; slot = (slot + 1) & mask)
+    {
+        const int32_t entry = mSlots[slot];
+        if (entry == EMPTY_SLOT)
+        {
+            return;
+        }
+        if (entry != REMOVED_SLOT && mEntries[entry].handle == handle && EqualsFolded(mEntries[entry].name, name))
+        {
+            break;
+        }
+    }
+
+    const int32_t entry = mSlots[slot];
+    mSlots[slot] = REMOVED_SLOT;
+    mNumRemoved++;
+
+    // Move the last entry into the hole and point its slot at the new position
+    const auto last = static_cast<int32_t>(mEntries.size() - 1);
+    if (entry != last)
+    {
+        const int lastSlot = FindSlot(mEntries[last].name, last);
+        mEntries[entry] = std::move(mEntries[last]);
+        mSlots[lastSlot] = entry;
+    }
+    mEntries.pop_back();
+}
+
+ActorHandle NameIndex::Find(const std::string_view name) const
+{
+    const int slot = FindFirstSlot(name);
+    return slot >= 0 ? mEntries[mSlots[slot]].handle : ActorHandle{};
+}
+
+void NameIndex::Clear()
+{
+    mEntries.clear();
+    mSlots.assign(16, EMPTY_SLOT);
+    mNumRemoved = 0;
+}
+
+int NameIndex::FindFirstSlot(const std::string_view name) const
+{
+    const auto mask = static_cast<uint32_t>(mSlots.size() - 1);
+    for (uint32_t slot = Hash(name) & mask;; slot = (slot + 1) & mask)
+    {
+        const int32_t entry = mSlots[slot];
+        if (entry == EMPTY_SLOT)
+        {
+            return -1;
+        }
+        if (entry != REMOVED_SLOT && EqualsFolded(mEntries[entry].name, name))
+        {
+            return static_cast<int>(slot);
+        }
+    }
+}
+
+int NameIndex::FindSlot(const std::string_view name, const int32_t entry) const
+{
+    const auto mask = static_cast<uint32_t>(mSlots.size() - 1);
+    for (uint32_t slot = Hash(name) & mask;; slot = (slot + 1) & mask)
+    {
+        if (mSlots[slot] == entry)
+        {
+            return static_cast<int>(slot);
+        }
+        if (mSlots[slot] == EMPTY_SLOT)
+        {
+            return -1;
+        }
+    }
+}
+
+void NameIndex::InsertSlot(const uint32_t hash, const int32_t entry)
+{
+    const auto mask = static_cast<uint32_t>(mSlots.size() - 1);
+    uint32_t slot = hash & mask;
+    while (mSlots[slot] >= 0)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    if (mSlots[slot] == REMOVED_SLOT)
+    {
+        mNumRemoved--;
+    }
+    mSlots[slot] = entry;
+}
+
+void NameIndex::Rehash(const size_t capacity)
+{
+    mSlots.assign(capacity, EMPTY_SLOT);
+    mNumRemoved = 0;
+
+    for (size_t i = 0; i < mEntries.size(); ++i)
+    {
+        InsertSlot(Hash(mEntries[i].name), static_cast<int32_t>(i));
+    }
+}
@@ -0,0 +1,53 @@
+//
+// NameIndex.h
+//
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../Actors/ActorHandle.h"
+
+// Case-insensitive map from actor name to handle. Names are stored lowercased
+// once (so lookups never allocate) in a dense array that can be iterated in
+// order; an open-addressing table with linear probing indexes into it.
+class NameIndex
+{
+public:
+    struct Entry
+    {
+        std::string name;
+        ActorHandle handle;
+    };
+
+    NameIndex();
+
+    // Adds a name; duplicates are all kept and Find returns one of them
+    void Insert(std::string_view name, ActorHandle handle);
+    // Removes the entry with this name and handle (no-op if missing)
+    void Remove(std::string_view name, ActorHandle handle);
+
+    // Handle for name (any letter case), or a null handle
+    ActorHandle Find(std::string_view name) const;
+
+    const std::vector<Entry>& GetEntries() const { return mEntries; }
+    void Clear();
+
+private:
+    static constexpr int32_t EMPTY_SLOT = -1;
+    static constexpr int32_t REMOVED_SLOT = -2;
+
+    static uint32_t Hash(std::string_view name);
+    static bool EqualsFolded(std::string_view folded, std::string_view name);
+
+    // Table slot holding entry, or -1
+    int FindSlot(std::string_view name, int32_t entry) const;
+    int FindFirstSlot(std::string_view name) const;
+    void InsertSlot(uint32_t hash, int32_t entry);
+    void Rehash(size_t capacity);
+
+    std::vector<Entry> mEntries;
+    std::vector<int32_t> mSlots;
+    size_t mNumRemoved;
+};
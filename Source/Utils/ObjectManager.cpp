@@ -9,53 +9,159 @@
 #include "../Actors/Cat.h"
 #include "../Actors/Block.h"
 #include "../Actors/Dog.h"
+#include "../Components/Physics/AABBColliderComponent.h"
+#include "TerminalHelper.h"
+#include "Log.h"
 #include <vector>
 #include <algorithm>
+#include <charconv>
 
-#include "TerminalHelper.h"
-
-ObjectManager::ObjectManager(Game *game) : mGame(game)
+namespace
 {
-}
+    bool ParseFloat(std::string_view &text, float &outValue)
+    {
+        while (!text.empty() && text.front() == ' ')
+            text.remove_prefix(1);
 
-Actor *ObjectManager::GetActorByName(std::string actorName) const
-{
-    std::vector<Actor *> allActors = mGame->GetAllActors();
-    for (Actor *actor : allActors)
+        const auto result = std::from_chars(text.data(), text.data() + text.size(), outValue);
+        if (result.ec != std::errc())
+            return false;
+
+        text.remove_prefix(result.ptr - text.data());
+        while (!text.empty() && text.front() == ' ')
+            text.remove_prefix(1);
+        return true;
+    }
+
+    // Parses "@inrect(x,y,w,h)" into the rectangle's corners
+    bool ParseRectSelector(std::string_view selector, Vector2 &outMin, Vector2 &outMax)
     {
-        if (actor->mIsManageable)
+        constexpr std::string_view prefix = "@inrect(";
+        if (selector.size() < prefix.size() || !MatchesCmd(selector.substr(0, prefix.size()), prefix) ||
+            selector.back() != ')')
+            return false;
+
+        std::string_view values = selector.substr(prefix.size(), selector.size() - prefix.size() - 1);
+        float rect[4];
+        for (int i = 0; i < 4; ++i)
         {
-            std::string actorNameStr = actor->GetActorName();
-            std::transform(actorNameStr.begin(), actorNameStr.end(), actorNameStr.begin(), ::tolower);
-            std::transform(actorName.begin(), actorName.end(), actorName.begin(), ::tolower);
-            if (actorNameStr == actorName)
-                return actor;
+            if (!ParseFloat(values, rect[i]))
+                return false;
+
+            if (i < 3)
+            {
+                if (values.empty() || values.front() != ',')
+                    return false;
+                values.remove_prefix(1);
+            }
         }
+
+        if (!values.empty() || rect[2] < 0.0f || rect[3] < 0.0f)
+            return false;
+
+        outMin = Vector2(rect[0], rect[1]);
+        outMax = Vector2(rect[0] + rect[2], rect[1] + rect[3]);
+        return true;
     }
-    return nullptr;
+}
+
+ObjectManager::ObjectManager(Game *game) : mGame(game)
+{
+    // Actors built with the level were flagged before this manager existed
+    for (Actor *actor : mGame->GetAllActors())
+    {
+        if (actor->IsManageable())
+            OnActorAdded(actor);
+    }
+}
+
+void ObjectManager::OnActorAdded(Actor *actor)
+{
+    mNameIndex.Insert(actor->GetActorName(), actor->GetHandle());
+}
+
+void ObjectManager::OnActorRemoved(Actor *actor)
+{
+    mNameIndex.Remove(actor->GetActorName(), actor->GetHandle());
+}
+
+Actor *ObjectManager::GetActorByName(const std::string_view actorName) const
+{
+    return mGame->GetActor(mNameIndex.Find(actorName));
 }
 
 std::vector<std::string_view> ObjectManager::GetAllObjNames() const
 {
-    std::vector<Actor *> allActors = mGame->GetAllActors();
     std::vector<std::string_view> objNames;
-    for (Actor *actor : allActors)
+    objNames.reserve(mNameIndex.GetEntries().size());
+    for (const auto &entry : mNameIndex.GetEntries())
     {
-        if (actor->mIsManageable)
-        {
-            std::string_view view(actor->GetActorName());
-            objNames.push_back(view);
-        }
+        if (Actor *actor = mGame->GetActor(entry.handle))
+            objNames.emplace_back(actor->GetActorName());
     }
     return objNames;
 }
 
-std::string ObjectManager::GetObjAttributes(const std::string &objName)
+bool ObjectManager::Select(const std::string_view selector, std::vector<Actor *> &outActors) const
+{
+    if (!selector.empty() && selector[0] == '@')
+    {
+        Vector2 min, max;
+        if (!ParseRectSelector(selector, min, max))
+            return false;
+
+        SelectInRect(min, max, outActors);
+        return true;
+    }
+
+    if (!IsGlobPattern(selector))
+    {
+        if (Actor *actor = GetActorByName(selector))
+            outActors.emplace_back(actor);
+        return true;
+    }
+
+    for (const auto &entry : mNameIndex.GetEntries())
+    {
+        if (!MatchesGlob(selector, entry.name))
+            continue;
+
+        if (Actor *actor = mGame->GetActor(entry.handle))
+            outActors.emplace_back(actor);
+    }
+    return true;
+}
+
+void ObjectManager::SelectInRect(const Vector2 &min, const Vector2 &max, std::vector<Actor *> &outActors) const
+{
+    // The broadphase grid narrows the search to the colliders near the rectangle
+    std::vector<AABBColliderComponent *> colliders;
+    mGame->GetCollisionGrid().Query(min, max, colliders);
+
+    const size_t firstSelected = outActors.size();
+    for (const AABBColliderComponent *collider : colliders)
+    {
+        Actor *owner = collider->GetOwner();
+        if (!owner->IsManageable() || owner->GetState() == ActorState::Destroy)
+            continue;
+
+        const Vector2 colliderMin = collider->GetMin();
+        const Vector2 colliderMax = collider->GetMax();
+        if (colliderMin.x < max.x && colliderMax.x > min.x && colliderMin.y < max.y && colliderMax.y > min.y)
+            outActors.emplace_back(owner);
+    }
+
+    // An actor with several colliders is selected once
+    std::sort(outActors.begin() + firstSelected, outActors.end());
+    outActors.erase(std::unique(outActors.begin() + firstSelected, outActors.end()), outActors.end());
+}
+
+std::string ObjectManager::GetObjAttributes(const std::string_view objName)
 {
     Actor *desiredActor = GetActorByName(objName);
     if (!desiredActor)
     {
-        SDL_LogError(0, "ObjectManager::GetObjAttributes called with wrong obj name: %s.", objName.c_str());
+        LOG_ERROR(Terminal, "ObjectManager::GetObjAttributes called with wrong obj name: %.*s.", static_cast<int>(objName.size()), objName.data());
         return {"none"};
     }
 
@@ -70,115 +176,150 @@ std::string ObjectManager::GetObjAttributes(const std::string &objName)
 }
 
 
-void ObjectManager::SetAttributeValue(const std::string &objName, const std::string &attributeName, const std::string &value)
+void ObjectManager::SetPosition(const std::string_view selector, const Vector2 &position)
+{
+    QueueEdit(selector, EditType::Position, position, "SetPosition");
+}
+
+void ObjectManager::SetRotation(const std::string_view selector, const float rotation)
+{
+    QueueEdit(selector, EditType::Rotation, Vector2(rotation, 0.0f), "SetRotation");
+}
+
+void ObjectManager::SetScale(const std::string_view selector, const Vector2 &scale)
+{
+    QueueEdit(selector, EditType::Scale, scale, "SetScale");
+}
+
+void ObjectManager::Jump()
+{
+    mGame->GetPlayer()->Jump();
+}
+
+void ObjectManager::DeleteObject(const std::string_view selector)
 {
-    Actor *actorToModify = GetActorByName(objName);
-    if (!actorToModify)
+    QueueEdit(selector, EditType::Delete, Vector2::Zero, "DeleteObject");
+}
+
+void ObjectManager::DisableDamage(const std::string_view selector)
+{
+    QueueEdit(selector, EditType::DisableDamage, Vector2::Zero, "DisableDamage");
+}
+
+void ObjectManager::EnableDamage(const std::string_view selector)
+{
+    QueueEdit(selector, EditType::EnableDamage, Vector2::Zero, "EnableDamage");
+}
+
+bool ObjectManager::QueueEdit(const std::string_view selector, const EditType type, const Vector2 &value, const char *caller)
+{
+    std::vector<Actor *> actors;
+    if (!Select(selector, actors))
     {
-        SDL_LogError(0, "ObjectManager::SetAttributeValue called with wrong obj name: %s.", objName.c_str());
-        return;
+        LOG_ERROR(Terminal, "ObjectManager::%s called with a malformed selector: %.*s.", caller, static_cast<int>(selector.size()), selector.data());
+        return false;
     }
 
-    // For position, it is expected value to be in the format: (x, y)
-    if (MatchesCmd(attributeName, "position"))
-    {
-        auto inner = value.substr(1, value.size() - 2);
-        auto comma = inner.find(',');
-        const int x = std::stoi(inner.substr(0, comma));
-        const int y = std::stoi(inner.substr(comma + 1));
-        // Verifica se a posição solicitada está dentro dos limites visíveis pela câmera
-        Vector2 cam = mGame->GetCameraPos();
-        float camLeft = cam.x;
-        float camTop = cam.y;
-        float camRight = camLeft + Game::WINDOW_WIDTH;
-        float camBottom = camTop + Game::WINDOW_HEIGHT;
-
-        // if (x < camLeft || x > camRight || y < camTop || y > camBottom)
-        // {
-        //     mGame->GetTerminal()->AddLine("Error: Requested position is outside camera bounds.");
-        //     SDL_Log("ObjectManager: requested position (%d,%d) is outside camera bounds; change ignored", x, y);
-        //     SDL_Log("camLeft: %d camRight: %d camTop: %d camBottom: %d", camLeft, camRight,camTop, camBottom);
-        //     return;
-        // }
-
-        const Vector2 newPos(static_cast<float>(x), static_cast<float>(y));
-        SDL_Log("setting obj position to: %d, %d", x, y);
-        actorToModify->SetPosition(newPos);
-        return;
-    }
-    // For rotation, it is expected value to be in the format: x
-    if (MatchesCmd(attributeName, "rotation"))
+    // Only dogs can deal damage
+    if (type == EditType::EnableDamage || type == EditType::DisableDamage)
     {
-        actorToModify->SetRotation(value.at(0) - '0');
-        return;
+        actors.erase(std::remove_if(actors.begin(), actors.end(), [](Actor *actor)
+        {
+            return dynamic_cast<Dog *>(actor) == nullptr;
+        }), actors.end());
     }
-    // For scale, it is expected value to be in the format: (x, y)
-    if (MatchesCmd(attributeName, "scale"))
+
+    if (actors.empty())
     {
-        auto inner = value.substr(1, value.size() - 2);
-        auto comma = inner.find(',');
-        const int x = std::stoi(inner.substr(0, comma));
-        const int y = std::stoi(inner.substr(comma + 1));
-        const Vector2 newScale(x, y);
-        actorToModify->SetScale(newScale);
-        return;
+        LOG_ERROR(Terminal, "ObjectManager::%s called with wrong obj name: %.*s.", caller, static_cast<int>(selector.size()), selector.data());
+        return false;
     }
-    if (attributeName == "damage")
+
+    for (Actor *actor : actors)
     {
-        if (value == "0")
-        {
-            SDL_Log("disabling damage");
-            DisableDamage(objName);
-        } else
-        {
-            SDL_Log("enabling damage");
-            EnableDamage(objName);
-        }
-        return;
+        mPendingEdits.emplace_back(PendingEdit{actor->GetHandle(), type, value});
     }
+    return true;
 }
 
-void ObjectManager::Jump()
+void ObjectManager::ApplyPendingEdits()
 {
-    mGame->GetPlayer()->Jump();
-}
+    if (mPendingEdits.empty())
+        return;
 
-void ObjectManager::DeleteObject(const std::string &objName)
-{
-    Actor *actorToDelete = GetActorByName(objName);
-    if (!actorToDelete)
+    // Bring each actor's edits together, keeping their order so the last one wins
+    std::stable_sort(mPendingEdits.begin(), mPendingEdits.end(), [](const PendingEdit &a, const PendingEdit &b)
     {
-        SDL_LogError(0, "ObjectManager::DeleteObject called with wrong obj name.");
-        return;
-    }
+        return a.handle.index != b.handle.index ? a.handle.index < b.handle.index
+                                                : a.handle.generation < b.handle.generation;
+    });
 
-    actorToDelete->SetState(ActorState::Destroy);
-}
+    mGame->SetDeferColliderUpdates(true);
 
-void ObjectManager::DisableDamage(const std::string &objName)
-{
-    Actor *actorToDelete = GetActorByName(objName);
-    Dog* dogToDelete = dynamic_cast<Dog*>(actorToDelete);
-    if (!dogToDelete)
+    const PendingEdit *edits = mPendingEdits.data();
+    const size_t count = mPendingEdits.size();
+    for (size_t first = 0; first < count;)
     {
-        SDL_LogError(0, "ObjectManager::RemoveDamage called with wrong obj name.");
-        return;
+        size_t last = first + 1;
+        while (last < count && edits[last].handle == edits[first].handle)
+            ++last;
+
+        // Actors destroyed since the command was issued are skipped
+        if (Actor *actor = mGame->GetActor(edits[first].handle))
+            ApplyEdits(actor, edits + first, edits + last);
+
+        first = last;
     }
 
-    dogToDelete->DisableDamage();
+    mGame->SetDeferColliderUpdates(false);
+    mPendingEdits.clear();
 }
 
-void ObjectManager::EnableDamage(const std::string &objName)
+void ObjectManager::ApplyEdits(Actor *actor, const PendingEdit *first, const PendingEdit *last)
 {
-    Actor *actorToDelete = GetActorByName(objName);
-    Dog* dogToDelete = dynamic_cast<Dog*>(actorToDelete);
-    if (!dogToDelete)
+    const PendingEdit *position = nullptr;
+    const PendingEdit *rotation = nullptr;
+    const PendingEdit *scale = nullptr;
+    const PendingEdit *damage = nullptr;
+
+    for (const PendingEdit *edit = first; edit != last; ++edit)
     {
-        SDL_LogError(0, "ObjectManager::RemoveDamage called with wrong obj name.");
-        return;
+        switch (edit->type)
+        {
+        case EditType::Position:
+            position = edit;
+            break;
+        case EditType::Rotation:
+            rotation = edit;
+            break;
+        case EditType::Scale:
+            scale = edit;
+            break;
+        case EditType::EnableDamage:
+        case EditType::DisableDamage:
+            damage = edit;
+            break;
+        case EditType::Delete:
+            actor->SetState(ActorState::Destroy);
+            return;
+        }
     }
 
-    dogToDelete->EnableDamage();
+    if (scale)
+        actor->SetScale(scale->value);
+    if (position)
+        actor->SetPosition(position->value);
+    if (rotation)
+        actor->SetRotation(rotation->value.x);
+
+    if (damage)
+    {
+        Dog *dog = static_cast<Dog *>(actor);
+        if (damage->type == EditType::EnableDamage)
+            dog->EnableDamage();
+        else
+            dog->DisableDamage();
+    }
 }
 
 std::string ObjectManager::AddObject(const Vector2 &playerRelativeLocation, const SpawnableObjects objectToAdd)
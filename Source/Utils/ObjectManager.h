@@ -3,10 +3,13 @@
 //
 
 #pragma once
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../Math.h"
+#include "NameIndex.h"
 
 class Game;
 class Actor;
@@ -21,21 +24,72 @@ class ObjectManager
 {
     Game* mGame = nullptr;
 
+    // Manageable actors by case-folded name, kept in sync by Actor/Game
+    NameIndex mNameIndex;
+
+    // Terminal edits waiting for the end of the frame
+    enum class EditType : uint8_t
+    {
+        Position,
+        Rotation,
+        Scale,
+        EnableDamage,
+        DisableDamage,
+        Delete
+    };
+
+    struct PendingEdit
+    {
+        ActorHandle handle;
+        EditType type;
+        Vector2 value;
+    };
+
+    std::vector<PendingEdit> mPendingEdits;
+
 private:
-    Actor* GetActorByName(std::string actorName) const;
+    Actor* GetActorByName(std::string_view actorName) const;
+
+    // Queues one edit per selected actor; false (and an error log) if none matched
+    bool QueueEdit(std::string_view selector, EditType type, const Vector2& value, const char* caller);
+    void SelectInRect(const Vector2& min, const Vector2& max, std::vector<Actor*>& outActors) const;
+    static void ApplyEdits(Actor* actor, const PendingEdit* first, const PendingEdit* last);
 
 public:
     ObjectManager(Game* game);
 
+    // Called when an actor becomes manageable (or is renamed) and when it stops being so
+    void OnActorAdded(Actor* actor);
+    void OnActorRemoved(Actor* actor);
+
     // Returns all names for objects that ARE MANAGEABLE.
     std::vector<std::string_view> GetAllObjNames() const;
 
-    std::string GetObjAttributes(const std::string& objName);
-    void SetAttributeValue(const std::string& objName, const std::string& attributeName, const std::string& value);
+    /**
+     * Resolves a terminal selector to the manageable actors it names:
+     *   Block3             the object with that name (any letter case)
+     *   block*, dog[0-9]   names matching a glob pattern (see MatchesGlob)
+     *   @inrect(x,y,w,h)   objects whose collider overlaps the world rectangle
+     * @return False if the selector is malformed
+     */
+    bool Select(std::string_view selector, std::vector<Actor*>& outActors) const;
+
+    std::string GetObjAttributes(std::string_view objName);
+
+    // Attribute setters used by the terminal's "set" command (values come already parsed).
+    // They apply to every object the selector matches, but only take effect in
+    // ApplyPendingEdits, so a frame's worth of commands lands as a single batch.
+    void SetPosition(std::string_view selector, const Vector2& position);
+    void SetRotation(std::string_view selector, float rotation);
+    void SetScale(std::string_view selector, const Vector2& scale);
+
+    // Applies the queued edits, each object once, re-filing colliders once per batch
+    void ApplyPendingEdits();
+
     void Jump();
-    void DeleteObject(const std::string& objName);
-    void DisableDamage(const std::string& objName);
-    void EnableDamage(const std::string& objName);
+    void DeleteObject(std::string_view selector);
+    void DisableDamage(std::string_view selector);
+    void EnableDamage(std::string_view selector);
 
     /**
      * @param playerRelativeLocation The location that the object will spawn, relative to the player
@@ -0,0 +1,133 @@
+//
+// Profiler.cpp
+//
+
+#include "Profiler.h"
+#include "Log.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    // Single-producer ring: only the owning thread writes, the dump reads
+    // up to the published head
+    struct ThreadBuffer
+    {
+        explicit ThreadBuffer(uint32_t threadId)
+            : threadId(threadId)
+            , head(0)
+            , events(Profiler::EVENTS_PER_THREAD)
+        {
+        }
+
+        uint32_t threadId;
+        std::atomic<uint64_t> head;
+        std::vector<Profiler::Event> events;
+    };
+
+    std::mutex sRegistryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> sBuffers;
+
+    ThreadBuffer* GetThreadBuffer()
+    {
+        // The lock is only taken the first time a thread records a zone
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer)
+        {
+            std::lock_guard<std::mutex> lock(sRegistryMutex);
+            sBuffers.emplace_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(sBuffers.size())));
+            buffer = sBuffers.back().get();
+        }
+        return buffer;
+    }
+
+    void WriteEscaped(std::ofstream& out, const char* text)
+    {
+        for (const char* c = text; *c; c++)
+        {
+            if (*c == '"' || *c == '\\')
+                out << '\\';
+            out << *c;
+        }
+    }
+}
+
+bool Profiler::IsEnabled()
+{
+#ifdef MIAOWARE_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t Profiler::NowNs()
+{
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+void Profiler::Record(const char* name, uint64_t startNs, uint64_t endNs)
+{
+    ThreadBuffer* buffer = GetThreadBuffer();
+
+    const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    buffer->events[head & (EVENTS_PER_THREAD - 1)] = Event{name, startNs, endNs - startNs};
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+bool Profiler::WriteChromeTrace(const std::string& filePath)
+{
+    std::ofstream out(filePath);
+    if (!out.is_open())
+    {
+        LOG_ERROR(Core, "Profiler: failed to open %s", filePath.c_str());
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(sRegistryMutex);
+
+    // Timestamps are relative to the oldest buffered event
+    uint64_t origin = UINT64_MAX;
+    for (const auto& buffer : sBuffers)
+    {
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        const uint64_t first = head > EVENTS_PER_THREAD ? head - EVENTS_PER_THREAD : 0;
+        for (uint64_t i = first; i < head; i++)
+        {
+            origin = std::min(origin, buffer->events[i & (EVENTS_PER_THREAD - 1)].startNs);
+        }
+    }
+
+    out << "{\"traceEvents\":[";
+    bool firstEvent = true;
+    size_t numEvents = 0;
+    for (const auto& buffer : sBuffers)
+    {
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        const uint64_t first = head > EVENTS_PER_THREAD ? head - EVENTS_PER_THREAD : 0;
+        for (uint64_t i = first; i < head; i++)
+        {
+            const Event& event = buffer->events[i & (EVENTS_PER_THREAD - 1)];
+
+            out << (firstEvent ? "\n" : ",\n");
+            out << "{\"name\":\"";
+            WriteEscaped(out, event.name);
+            out << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->threadId
+                << ",\"ts\":" << static_cast<double>(event.startNs - origin) / 1000.0
+                << ",\"dur\":" << static_cast<double>(event.durationNs) / 1000.0 << "}";
+
+            firstEvent = false;
+            numEvents++;
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    LOG_INFO(Core, "Profiler: wrote %zu events to %s", numEvents, filePath.c_str());
+    return true;
+}
@@ -0,0 +1,69 @@
+//
+// Profiler.h
+//
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Scoped frame profiler. Zones are recorded into a per-thread ring buffer
+// and can be dumped as Chrome trace_event JSON (open in chrome://tracing
+// or https://ui.perfetto.dev).
+//
+// The PROFILE_* macros only exist in builds configured with
+// MIAOWARE_PROFILING; otherwise they expand to nothing.
+class Profiler
+{
+public:
+    // Most recent events kept per thread
+    static constexpr uint32_t EVENTS_PER_THREAD = 1u << 16;
+
+    struct Event
+    {
+        const char* name;
+        uint64_t startNs;
+        uint64_t durationNs;
+    };
+
+    static bool IsEnabled();
+
+    static uint64_t NowNs();
+
+    // Appends a finished zone to the calling thread's ring buffer
+    static void Record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Writes every buffered event as Chrome trace JSON. Meant to be called
+    // from the game thread between frames.
+    static bool WriteChromeTrace(const std::string& filePath);
+};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name)
+        : mName(name)
+        , mStartNs(Profiler::NowNs())
+    {
+    }
+
+    ~ProfileScope()
+    {
+        Profiler::Record(mName, mStartNs, Profiler::NowNs());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* mName;
+    uint64_t mStartNs;
+};
+
+#ifdef MIAOWARE_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+// name must be a string literal (or otherwise outlive the trace dump)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name)
+#endif
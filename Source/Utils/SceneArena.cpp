@@ -0,0 +1,81 @@
+//
+// SceneArena.cpp
+//
+
+#include "SceneArena.h"
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+    constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+
+    size_t AlignUp(size_t size)
+    {
+        return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+}
+
+SceneArena& SceneArena::Get()
+{
+    static SceneArena arena;
+    return arena;
+}
+
+void* SceneArena::Allocate(size_t size)
+{
+    size = AlignUp(std::max<size_t>(size, 1));
+
+    // Move on to the next block that fits, adding one if none does. Oversized
+    // objects get a block of their own, dropped again on Reset.
+    while (mCurrentBlock < mBlocks.size() && mOffset + size > mBlocks[mCurrentBlock].size)
+    {
+        mCurrentBlock++;
+        mOffset = 0;
+    }
+
+    if (mCurrentBlock == mBlocks.size())
+    {
+        const size_t blockSize = std::max(BLOCK_SIZE, size);
+        mBlocks.emplace_back(Block{std::make_unique<unsigned char[]>(blockSize), blockSize});
+        mOffset = 0;
+    }
+
+    void* p = mBlocks[mCurrentBlock].data.get() + mOffset;
+    mOffset += size;
+
+    mLiveCount++;
+    mStats.allocations++;
+    mStats.bytes += size;
+    mStats.blocks = std::max(mStats.blocks, mCurrentBlock + 1);
+    return p;
+}
+
+void SceneArena::Free(void* p)
+{
+    if (!p)
+        return;
+
+    assert(mLiveCount > 0);
+    mLiveCount--;
+}
+
+void SceneArena::Reset()
+{
+    assert(mLiveCount == 0);
+
+    mBlocks.erase(std::remove_if(mBlocks.begin(), mBlocks.end(), [](const Block& block)
+    {
+        return block.size != BLOCK_SIZE;
+    }), mBlocks.end());
+
+    mCurrentBlock = 0;
+    mOffset = 0;
+    mStats = Stats();
+}
+
+void SceneArena::Release()
+{
+    Reset();
+    mBlocks.clear();
+}
@@ -0,0 +1,56 @@
+//
+// SceneArena.h
+//
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Bump allocator for objects that live no longer than the current scene:
+// actors and the components that have no pool of their own route their
+// class-level operator new/delete here. Deleting one still runs its
+// destructor, but the memory only comes back when Game releases the whole
+// scene and rewinds the arena.
+class SceneArena
+{
+public:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    // Allocations made since the last Reset
+    struct Stats
+    {
+        size_t allocations = 0;
+        size_t bytes = 0;
+        size_t blocks = 0;
+    };
+
+    static SceneArena& Get();
+
+    void* Allocate(size_t size);
+    void Free(void* p);
+
+    // Rewinds to empty, keeping regular blocks for the next scene. Every
+    // object allocated here must have been destroyed.
+    void Reset();
+    // Like Reset, but also returns every block to the system
+    void Release();
+
+    const Stats& GetStats() const { return mStats; }
+    size_t GetLiveCount() const { return mLiveCount; }
+
+private:
+    struct Block
+    {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> mBlocks;
+    // Block being bumped into, and the offset of its first free byte
+    size_t mCurrentBlock = 0;
+    size_t mOffset = 0;
+
+    size_t mLiveCount = 0;
+    Stats mStats;
+};
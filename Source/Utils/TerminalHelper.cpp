@@ -3,12 +3,168 @@
 //
 
 #include "TerminalHelper.h"
+#include <cstdint>
 
-bool MatchesCmd(const std::string& input, const std::string& full)
+namespace
 {
-  if (input == full) return true;
-  if (input.size() == 1 && full.size() > 1 && input[0] == full[0])
+  bool IsDigit(const char c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  // Parses "<digits>-<digits>" with at least one multi-digit bound
+  bool ParseNumericRange(std::string_view set, unsigned &outLow, unsigned &outHigh)
+  {
+    const size_t dash = set.find('-');
+    if (dash == std::string_view::npos || dash == 0 || dash + 1 == set.size())
+      return false;
+
+    const std::string_view low = set.substr(0, dash);
+    const std::string_view high = set.substr(dash + 1);
+    if (low.size() == 1 && high.size() == 1)
+      return false;
+
+    outLow = outHigh = 0;
+    for (const char c : low)
+    {
+      if (!IsDigit(c))
+        return false;
+      outLow = outLow * 10 + (c - '0');
+    }
+    for (const char c : high)
+    {
+      if (!IsDigit(c))
+        return false;
+      outHigh = outHigh * 10 + (c - '0');
+    }
     return true;
+  }
+
+  bool MatchesSet(std::string_view set, const char c)
+  {
+    bool negate = false;
+    if (!set.empty() && set[0] == '!')
+    {
+      negate = true;
+      set.remove_prefix(1);
+    }
+
+    bool found = false;
+    for (size_t i = 0; i < set.size() && !found; ++i)
+    {
+      if (i + 2 < set.size() && set[i + 1] == '-')
+      {
+        found = c >= FoldCase(set[i]) && c <= FoldCase(set[i + 2]);
+        i += 2;
+      }
+      else
+      {
+        found = c == FoldCase(set[i]);
+      }
+    }
+    return found != negate;
+  }
+
+  // Matches the bracket expression "set" at the start of name; returns how many
+  // characters of name it consumed, or 0 if it doesn't match
+  size_t MatchBracket(std::string_view set, std::string_view name)
+  {
+    unsigned low, high;
+    if (ParseNumericRange(set, low, high))
+    {
+      size_t length = 0;
+      unsigned value = 0;
+      while (length < name.size() && IsDigit(name[length]))
+      {
+        // Anything with more digits than fit is out of any range we can express
+        if (value > (UINT32_MAX - 9) / 10)
+          return 0;
+        value = value * 10 + (name[length] - '0');
+        ++length;
+      }
+      return length > 0 && value >= low && value <= high ? length : 0;
+    }
+
+    return !name.empty() && MatchesSet(set, FoldCase(name[0])) ? 1 : 0;
+  }
+}
+
+bool MatchesCmd(std::string_view input, std::string_view full)
+{
+  if (input.size() == 1 && full.size() > 1)
+    return FoldCase(input[0]) == full[0];
 
-  return false;
-}
\ No newline at end of file
+  if (input.size() != full.size())
+    return false;
+
+  for (size_t i = 0; i < input.size(); ++i)
+  {
+    if (FoldCase(input[i]) != full[i])
+      return false;
+  }
+  return true;
+}
+bool MatchesGlob(const std::string_view pattern, const std::string_view name)
+{
+  size_t p = 0;
+  size_t n = 0;
+
+  // Where to resume if the rest fails to match after the last '*'
+  size_t starP = std::string_view::npos;
+  size_t starN = 0;
+
+  while (n < name.size())
+  {
+    if (p < pattern.size() && pattern[p] == '*')
+    {
+      starP = ++p;
+      starN = n;
+      continue;
+    }
+
+    size_t patternLength = 1;
+    size_t nameLength = 0;
+    if (p < pattern.size())
+    {
+      if (pattern[p] == '?')
+      {
+        nameLength = 1;
+      }
+      else if (pattern[p] == '[' && pattern.find(']', p + 1) != std::string_view::npos)
+      {
+        const size_t close = pattern.find(']', p + 1);
+        patternLength = close - p + 1;
+        nameLength = MatchBracket(pattern.substr(p + 1, close - p - 1), name.substr(n));
+      }
+      else if (FoldCase(pattern[p]) == FoldCase(name[n]))
+      {
+        nameLength = 1;
+      }
+    }
+
+    if (nameLength > 0)
+    {
+      p += patternLength;
+      n += nameLength;
+    }
+    else if (starP != std::string_view::npos)
+    {
+      // Let the last '*' swallow one more character and retry
+      p = starP;
+      n = ++starN;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  while (p < pattern.size() && pattern[p] == '*')
+    ++p;
+  return p == pattern.size();
+}
+
+bool IsGlobPattern(const std::string_view pattern)
+{
+  return pattern.find_first_of("*?[") != std::string_view::npos;
+}
@@ -3,6 +3,23 @@
 //
 
 // TerminalHelper.h
-#include <string>
+#pragma once
+#include <string_view>
 
-bool MatchesCmd(const std::string& input, const std::string& full);
+// ASCII lowercase; every case-insensitive name comparison goes through this
+inline char FoldCase(const char c)
+{
+  return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// True if input is full or its first letter (ignoring case)
+bool MatchesCmd(std::string_view input, std::string_view full);
+
+// True if name matches the glob pattern (ignoring case): '*' matches any run of
+// characters, '?' any one character, '[a-z]' / '[!abc]' one character of a set.
+// A bracket whose bounds are multi-digit numbers, like '[0-20]', matches a whole
+// run of digits whose value lies in the range.
+bool MatchesGlob(std::string_view pattern, std::string_view name);
+
+// True if the pattern uses any of the glob metacharacters above
+bool IsGlobPattern(std::string_view pattern);